@@ -11,5 +11,6 @@ if(${CMAKE_FIND_PACKAGE_NAME}_FIND_REQUIRED)
 endif()
 
 include("${CMAKE_CURRENT_LIST_DIR}/dbc-driver-genTargets.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/dbc-driver-genFunctions.cmake")
 
 set(dbc-driver-gen_FOUND TRUE)
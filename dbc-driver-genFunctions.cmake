@@ -0,0 +1,167 @@
+# Templates are installed next to the CMake package files
+get_filename_component(DBC_DRIVER_GEN_TEMPLATES_DIR
+  "${CMAKE_CURRENT_LIST_DIR}/../templates" ABSOLUTE
+)
+
+# dbc_driver_generate(
+#   TARGET <target>
+#   DBC <dbc_file>
+#   PROJECT_NAME <snake_case_name>
+#   [COPYRIGHT_HOLDER <holder>]
+#   [OUTPUT_DIR <dir>]
+#   [TEMPLATES_DIR <dir>]
+#   [VALUES <double|fixed_point|raw>]
+#   [USE_IO_URING]
+# )
+#
+# Generate a driver from a DBC file at build time and create a shared library
+# target from the generated sources. Generation only reruns when the DBC or a
+# template changes, and generated files whose content did not change keep their
+# timestamps, so dependent code is only recompiled when the output differs.
+# VALUES fixed_point decodes scaled signals to fixed-point integers or floats where
+# they represent the signal, instead of doubles, and raw keeps their raw integers.
+# USE_IO_URING builds the io_uring event loop if liburing 2.4 or newer is found.
+function(dbc_driver_generate)
+  cmake_parse_arguments(ARG
+    "USE_IO_URING"
+    "TARGET;DBC;PROJECT_NAME;COPYRIGHT_HOLDER;OUTPUT_DIR;TEMPLATES_DIR;VALUES"
+    ""
+    ${ARGN}
+  )
+
+  foreach(required_arg TARGET DBC PROJECT_NAME)
+    if(NOT ARG_${required_arg})
+      message(FATAL_ERROR "dbc_driver_generate: ${required_arg} is required")
+    endif()
+  endforeach()
+
+  if(NOT ARG_COPYRIGHT_HOLDER)
+    set(ARG_COPYRIGHT_HOLDER "${ARG_PROJECT_NAME} authors")
+  endif()
+  if(NOT ARG_OUTPUT_DIR)
+    set(ARG_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${ARG_TARGET}_generated")
+  endif()
+  if(NOT ARG_TEMPLATES_DIR)
+    set(ARG_TEMPLATES_DIR "${DBC_DRIVER_GEN_TEMPLATES_DIR}")
+  endif()
+  if(NOT ARG_VALUES)
+    set(ARG_VALUES double)
+  endif()
+
+  if(TARGET DbcDriverGen::dbc-driver)
+    set(generator DbcDriverGen::dbc-driver)
+  else()
+    set(generator dbc-driver)
+  endif()
+
+  get_filename_component(dbc_file "${ARG_DBC}" ABSOLUTE)
+  string(TOLOWER "${ARG_PROJECT_NAME}" name_lower)
+
+  set(project_dir "${ARG_OUTPUT_DIR}/${name_lower}")
+  set(include_dir "${project_dir}/include/${name_lower}")
+  set(stamp_file "${ARG_OUTPUT_DIR}/${ARG_TARGET}.stamp")
+  set(depfile "${ARG_OUTPUT_DIR}/${ARG_TARGET}.d")
+
+  set(generated_headers
+    "${include_dir}/visibility_control.hpp"
+    "${include_dir}/socket_can_bcm.hpp"
+    "${include_dir}/socket_can_common.hpp"
+    "${include_dir}/socket_can_id.hpp"
+    "${include_dir}/socket_can_event_loop.hpp"
+    "${include_dir}/socket_can_receiver.hpp"
+    "${include_dir}/socket_can_scheduler.hpp"
+    "${include_dir}/socket_can_uring.hpp"
+    "${include_dir}/change_detector.hpp"
+    "${include_dir}/frame_queue.hpp"
+    "${include_dir}/seqlock.hpp"
+    "${include_dir}/timer_wheel.hpp"
+    "${include_dir}/fixed_point.hpp"
+    "${include_dir}/vector_decode.hpp"
+    "${include_dir}/${ARG_PROJECT_NAME}_dbc.hpp"
+    "${include_dir}/${ARG_PROJECT_NAME}_driver.hpp"
+    "${include_dir}/${ARG_PROJECT_NAME}_callbacks.hpp"
+    "${include_dir}/${ARG_PROJECT_NAME}_multi_bus_driver.hpp"
+  )
+  set(generated_sources
+    "${project_dir}/src/socket_can_bcm.cpp"
+    "${project_dir}/src/socket_can_common.cpp"
+    "${project_dir}/src/socket_can_event_loop.cpp"
+    "${project_dir}/src/socket_can_id.cpp"
+    "${project_dir}/src/socket_can_receiver.cpp"
+    "${project_dir}/src/socket_can_scheduler.cpp"
+    "${project_dir}/src/timer_wheel.cpp"
+    "${project_dir}/src/${ARG_PROJECT_NAME}_driver.cpp"
+    "${project_dir}/src/${ARG_PROJECT_NAME}_multi_bus_driver.cpp"
+  )
+  set(generated_other
+    "${project_dir}/src/socket_can_uring.cpp"
+    "${project_dir}/bench/${ARG_PROJECT_NAME}_dbc_benchmark.cpp"
+    "${project_dir}/bench/${ARG_PROJECT_NAME}_latest_value_benchmark.cpp"
+    "${project_dir}/bench/${ARG_PROJECT_NAME}_callbacks_benchmark.cpp"
+    "${project_dir}/bench/${ARG_PROJECT_NAME}_queue_benchmark.cpp"
+    "${project_dir}/bench/${ARG_PROJECT_NAME}_rx_benchmark.cpp"
+    "${project_dir}/bench/${ARG_PROJECT_NAME}_tx_benchmark.cpp"
+    "${project_dir}/CMakeLists.txt"
+    "${project_dir}/cmake_uninstall.cmake.in"
+  )
+
+  file(GLOB_RECURSE template_files CONFIGURE_DEPENDS "${ARG_TEMPLATES_DIR}/driver/*")
+
+  set(depfile_args)
+  if(CMAKE_GENERATOR MATCHES "Ninja" OR NOT CMAKE_VERSION VERSION_LESS 3.20)
+    set(depfile_args DEPFILE "${depfile}")
+  endif()
+
+  file(MAKE_DIRECTORY "${ARG_OUTPUT_DIR}")
+
+  add_custom_command(
+    OUTPUT "${stamp_file}"
+    BYPRODUCTS ${generated_headers} ${generated_sources} ${generated_other}
+    COMMAND ${generator}
+      "${dbc_file}" "${ARG_COPYRIGHT_HOLDER}" "${ARG_PROJECT_NAME}" "${ARG_OUTPUT_DIR}"
+      --templates_path "${ARG_TEMPLATES_DIR}"
+      --values "${ARG_VALUES}"
+      --stamp "${stamp_file}"
+      --depfile "${depfile}"
+      --quiet
+    DEPENDS "${dbc_file}" ${template_files} ${generator}
+    ${depfile_args}
+    COMMENT "Generating driver ${ARG_PROJECT_NAME} from ${ARG_DBC}"
+    VERBATIM
+  )
+
+  add_custom_target(${ARG_TARGET}_generate DEPENDS "${stamp_file}")
+
+  add_library(${ARG_TARGET} SHARED ${generated_sources} ${generated_headers})
+  add_dependencies(${ARG_TARGET} ${ARG_TARGET}_generate)
+
+  target_include_directories(${ARG_TARGET}
+    PUBLIC
+      $<BUILD_INTERFACE:${project_dir}/include>
+  )
+
+  target_compile_features(${ARG_TARGET} PUBLIC cxx_std_17)
+  set_target_properties(${ARG_TARGET} PROPERTIES CXX_EXTENSIONS OFF)
+
+  # Receiving threads of the multi-bus driver
+  find_package(Threads REQUIRED)
+  target_link_libraries(${ARG_TARGET} PRIVATE Threads::Threads)
+
+  if(ARG_USE_IO_URING)
+    find_package(PkgConfig)
+
+    if(PkgConfig_FOUND)
+      pkg_check_modules(${ARG_TARGET}_LIBURING IMPORTED_TARGET liburing>=2.4)
+    endif()
+
+    if(${ARG_TARGET}_LIBURING_FOUND)
+      string(TOUPPER "${ARG_PROJECT_NAME}" name_upper)
+      target_sources(${ARG_TARGET} PRIVATE "${project_dir}/src/socket_can_uring.cpp")
+      target_link_libraries(${ARG_TARGET} PRIVATE PkgConfig::${ARG_TARGET}_LIBURING)
+      target_compile_definitions(${ARG_TARGET} PUBLIC ${name_upper}_HAS_IO_URING)
+    else()
+      message(WARNING
+        "dbc_driver_generate: liburing 2.4 or newer not found, ${ARG_TARGET} uses epoll")
+    endif()
+  endif()
+endfunction()
@@ -0,0 +1,52 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DBC_DRIVER_GEN__CAN_FILTER_HPP_
+#define DBC_DRIVER_GEN__CAN_FILTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DbcDriverGen
+{
+
+/// Most filters a CAN_RAW socket accepts (CAN_RAW_FILTER_MAX)
+constexpr std::size_t MAX_CAN_FILTERS = 512U;
+
+/// A SocketCAN receive filter: a frame passes if (frame_id & mask) == (id & mask)
+struct CanFilter
+{
+  uint32_t id;
+  uint32_t mask;
+};
+
+/// Build a short list of receive filters passing exactly the given frames
+///
+/// Keys are SocketCAN style identifiers: the CAN ID with bit 31 set for extended frames.
+/// IDs are merged into masked filters (the prime implicants of the ID set, as in
+/// Quine-McCluskey), which never pass another ID, and a greedy cover picks among them.
+/// Masks always include the extended and remote frame flags, so remote frames and frames of
+/// the other format are dropped. Only if more than max_filters filters remain, the closest
+/// filters are merged further and pass some IDs not in keys.
+/// \param[in] keys Dispatch keys of the frames to receive
+/// \param[in] max_filters Maximum number of filters to return
+/// \return Filters sorted by ID, standard before extended frames
+std::vector<CanFilter> build_can_filters(
+  const std::vector<uint32_t> & keys, std::size_t max_filters = MAX_CAN_FILTERS);
+
+}  // namespace DbcDriverGen
+
+#endif  // DBC_DRIVER_GEN__CAN_FILTER_HPP_
@@ -0,0 +1,53 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DBC_DRIVER_GEN__DBC_ATTRIBUTES_HPP_
+#define DBC_DRIVER_GEN__DBC_ATTRIBUTES_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace DbcDriverGen
+{
+
+/// Values of an attribute of messages (BO_), e.g. GenMsgCycleTime
+struct MessageAttribute
+{
+  /// Value given by BA_DEF_DEF_, empty if the DBC has none
+  std::string default_value;
+  /// Values given by BA_, keyed by the message ID as written in the DBC
+  std::map<uint32_t, std::string> values;
+  /// Names of the values of an ENUM attribute in the order of BA_DEF_, empty for other types
+  std::vector<std::string> enum_values;
+
+  /// Value of the attribute for a message, the default if it has none
+  const std::string & value(uint32_t message_id) const;
+
+  /// Value of an ENUM attribute for a message as the name of the value. BA_ gives the index
+  /// of the value while BA_DEF_DEF_ gives its name, so both are returned as the name.
+  std::string enum_value(uint32_t message_id) const;
+};
+
+/// Collect the values of a message attribute. String values are returned without quotes.
+/// \param[in] lines DBC lines the parser did not consume, see Libdbc::DbcParser::unused_lines()
+/// \param[in] name Name of the attribute
+MessageAttribute parse_message_attribute(
+  const std::vector<std::string> & lines, const std::string & name);
+
+}  // namespace DbcDriverGen
+
+#endif  // DBC_DRIVER_GEN__DBC_ATTRIBUTES_HPP_
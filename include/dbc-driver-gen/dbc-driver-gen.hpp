@@ -15,10 +15,19 @@
 #ifndef DBC_DRIVER_GEN__DBC_DRIVER_GEN_HPP_
 #define DBC_DRIVER_GEN__DBC_DRIVER_GEN_HPP_
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <istream>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "dbc-driver-gen/output-sink.hpp"
+#include "dbc-driver-gen/profiler.hpp"
+#include "dbc-driver-gen/signal-layout.hpp"
 #include "dbc-driver-gen/third-party/inja.hpp"
 #include "dbc-driver-gen/third-party/libdbc.hpp"
 
@@ -28,39 +37,120 @@ namespace DbcDriverGen
 class DbcDriverGenerator
 {
 public:
+  /// \param[in] profiler Records timing of every generation phase if not null, must outlive
+  /// the generator
   DbcDriverGenerator(
     const std::string & dbc_path,
     const std::string & copyright_holder,
-    const std::string & project_name);
+    const std::string & project_name,
+    Profiler * profiler = nullptr);
 
+  /// Parse the DBC from an already opened stream instead of a file
+  DbcDriverGenerator(
+    std::istream & dbc_stream,
+    const std::string & copyright_holder,
+    const std::string & project_name,
+    Profiler * profiler = nullptr);
+
+  /// Generate the driver into output_path / project_name on disk
   void generate_driver(const std::string & output_path, const std::string & templates_path);
 
+  /// Generate the driver and hand every file to the given sink
+  /// \param[in] templates_path The directory containing the Inja template files
+  /// \param[in] sink Receives each file with a path relative to the project root
+  void generate_driver(const std::string & templates_path, OutputSink & sink);
+
+  /// Generate the driver in memory
+  /// \param[in] templates_path The directory containing the Inja template files
+  /// \return Every generated file, keyed by its path relative to the project root
+  GeneratedFiles generate_driver_files(const std::string & templates_path);
+
+  /// Write a Makefile style dependency file listing the DBC and every template used by the
+  /// last call to generate_driver()
+  /// \param[in] depfile_path Path of the dependency file to write
+  /// \param[in] target The output which depends on the inputs, usually a stamp file
+  void write_depfile(
+    const std::filesystem::path & depfile_path,
+    const std::filesystem::path & target) const;
+
+  /// Set the stream used for progress messages, nullptr disables them. Defaults to std::cout.
+  void set_log_stream(std::ostream * log) noexcept {m_log = log;}
+
+  /// Set how the generated codecs represent physical values. Defaults to doubles.
+  void set_value_representation(ValueRepresentation representation) noexcept
+  {
+    m_value_representation = representation;
+  }
+
 private:
+  /// A single generated file: rendered from a template or copied verbatim when data is null.
+  /// Per-message templates are rendered once with pass "head", once per message with pass
+  /// "message" and the message description, and once with pass "tail".
+  struct OutputFile
+  {
+    std::filesystem::path template_file;
+    std::filesystem::path output_file;
+    const inja::json * data;
+    bool per_message;
+  };
+
+  void init(std::istream & dbc_stream, const std::string & copyright_holder);
+  std::filesystem::path check_templates_folder(const std::string & templates_path);
+  void log_phase_durations();
   std::string generate_copyright(const std::string & copyright_holder);
   void generate_dbc_json();
+  inja::json message_summary_json(const Libdbc::Message & msg, std::size_t index) const;
+  inja::json message_json(const Libdbc::Message & msg, std::size_t index) const;
+  /// Kernel receive filters passing exactly the frames with the given dispatch keys
+  static inja::json filters_json(const std::vector<uint32_t> & keys);
   void generate_header_files(
     const std::filesystem::path & output_folder,
-    const std::filesystem::path & templates_folder
+    const std::filesystem::path & templates_folder,
+    std::vector<OutputFile> & outputs
   );
   void generate_source_files(
     const std::filesystem::path & output_folder,
-    const std::filesystem::path & templates_folder
+    const std::filesystem::path & templates_folder,
+    std::vector<OutputFile> & outputs
+  );
+  void generate_benchmark_files(
+    const std::filesystem::path & output_folder,
+    const std::filesystem::path & templates_folder,
+    std::vector<OutputFile> & outputs
   );
   void generate_cmake(
     const std::filesystem::path & output_folder,
-    const std::filesystem::path & templates_folder
+    const std::filesystem::path & templates_folder,
+    std::vector<OutputFile> & outputs
   );
+  void render_outputs(const std::vector<OutputFile> & outputs, OutputSink & sink);
+  void render_output(
+    const OutputFile & output, const inja::Template & tmpl, std::ostream & os);
 
   std::string m_project_name_snake;
   std::string m_project_name_camel;
   std::string m_project_name_upper;
   std::string m_project_name_lower;
   std::string m_copyright;
+  std::filesystem::path m_dbc_path;
+  std::vector<std::filesystem::path> m_input_files;
 
   Libdbc::DbcParser m_parser;
+  std::vector<Libdbc::Message> m_messages;
+  /// GenMsgCycleTime in milliseconds per message, zero for messages which are not cyclic
+  std::vector<uint32_t> m_cycle_times;
+  /// CANFD_* flags per message: FDF and optionally BRS for CAN FD frames, zero for classic CAN
+  std::vector<uint8_t> m_fd_flags;
   inja::Environment m_inja_env;
   inja::json m_common_json;
   inja::json m_dbc_json;
+
+  std::ostream * m_log;
+  ValueRepresentation m_value_representation{ValueRepresentation::DOUBLE};
+  Profiler * m_profiler;
+
+  std::chrono::nanoseconds m_parse_duration;
+  std::vector<std::pair<std::string, std::chrono::nanoseconds>> m_phase_durations;
 };
 
 }  // namespace DbcDriverGen
@@ -0,0 +1,66 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DBC_DRIVER_GEN__DISPATCH_TABLE_HPP_
+#define DBC_DRIVER_GEN__DISPATCH_TABLE_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace DbcDriverGen
+{
+
+/// Largest dispatch key which is looked up directly instead of hashed (all 11-bit IDs)
+constexpr uint32_t DIRECT_DISPATCH_MAX_KEY = 0x7FFU;
+
+/// Lookup table mapping dispatch keys to message indices in O(1)
+///
+/// Keys are SocketCAN style identifiers: the CAN ID with bit 31 set for extended frames.
+/// If every key is a standard 11-bit ID the table is a direct index. Otherwise it is a
+/// minimal perfect hash built with hash and displace: a key falls into bucket
+/// dispatch_reduce(dispatch_hash(key, 0), num_buckets), and the key's slot is
+/// dispatch_reduce(dispatch_hash(key, displacements[bucket]), num_keys).
+struct DispatchTable
+{
+  bool is_direct;
+  uint32_t num_buckets;
+  std::vector<uint32_t> displacements;
+};
+
+/// 32-bit mixing hash. Generated drivers contain an identical implementation.
+constexpr uint32_t dispatch_hash(uint32_t key, uint32_t seed)
+{
+  uint32_t hash = key ^ (seed * 0x9E3779B9U);
+  hash ^= hash >> 16U;
+  hash *= 0x85EBCA6BU;
+  hash ^= hash >> 13U;
+  hash *= 0xC2B2AE35U;
+  hash ^= hash >> 16U;
+  return hash;
+}
+
+/// Map a hash onto [0, range) without a division
+constexpr uint32_t dispatch_reduce(uint32_t hash, uint32_t range)
+{
+  return static_cast<uint32_t>((static_cast<uint64_t>(hash) * range) >> 32U);
+}
+
+/// Build the dispatch table for a set of unique keys
+/// \param[in] keys Dispatch keys of all messages, in message order
+DispatchTable build_dispatch_table(const std::vector<uint32_t> & keys);
+
+}  // namespace DbcDriverGen
+
+#endif  // DBC_DRIVER_GEN__DISPATCH_TABLE_HPP_
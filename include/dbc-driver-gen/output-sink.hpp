@@ -0,0 +1,95 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DBC_DRIVER_GEN__OUTPUT_SINK_HPP_
+#define DBC_DRIVER_GEN__OUTPUT_SINK_HPP_
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace DbcDriverGen
+{
+
+class Profiler;
+
+/// Generated files, keyed by their path relative to the root of the generated project
+using GeneratedFiles = std::map<std::filesystem::path, std::string>;
+
+/// Receives generated files as soon as they have been rendered
+class OutputSink
+{
+public:
+  virtual ~OutputSink() = default;
+
+  /// Consume a single generated file. May be called concurrently from several threads.
+  /// \param[in] relative_path Path of the file relative to the root of the generated project
+  /// \param[in] content The full content of the file
+  virtual void write(const std::filesystem::path & relative_path, const std::string & content) = 0;
+
+  /// Consume a single generated file whose content is streamed by the producer. The default
+  /// implementation collects the content in memory and passes it to write().
+  /// \param[in] relative_path Path of the file relative to the root of the generated project
+  /// \param[in] producer Writes the full content of the file to the given stream
+  virtual void write_stream(
+    const std::filesystem::path & relative_path,
+    const std::function<void(std::ostream &)> & producer);
+};
+
+/// Writes generated files below a directory on disk, creating subdirectories as needed.
+/// Existing files whose content is unchanged are not rewritten. Streamed content goes
+/// through a buffered temporary file and is never held in memory as a whole.
+class DirectorySink : public OutputSink
+{
+public:
+  /// \param[in] root_folder The folder which becomes the root of the generated project
+  /// \param[in] profiler Records the flush, comparison and rename of every streamed file as a
+  /// "write file" event, may be null
+  explicit DirectorySink(const std::filesystem::path & root_folder, Profiler * profiler = nullptr);
+
+  void write(const std::filesystem::path & relative_path, const std::string & content) override;
+
+  void write_stream(
+    const std::filesystem::path & relative_path,
+    const std::function<void(std::ostream &)> & producer) override;
+
+  const std::filesystem::path & root_folder() const noexcept {return m_root_folder;}
+
+private:
+  std::filesystem::path prepare_output_file(const std::filesystem::path & relative_path) const;
+
+  std::filesystem::path m_root_folder;
+  Profiler * m_profiler;
+};
+
+/// Collects generated files in memory
+class MemorySink : public OutputSink
+{
+public:
+  void write(const std::filesystem::path & relative_path, const std::string & content) override;
+
+  /// Move the collected files out of the sink, leaving it empty
+  GeneratedFiles take_files();
+
+private:
+  std::mutex m_mutex;
+  GeneratedFiles m_files;
+};
+
+}  // namespace DbcDriverGen
+
+#endif  // DBC_DRIVER_GEN__OUTPUT_SINK_HPP_
@@ -0,0 +1,94 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DBC_DRIVER_GEN__PROFILER_HPP_
+#define DBC_DRIVER_GEN__PROFILER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DbcDriverGen
+{
+
+/// Records wall time, thread CPU time and allocation counts of generation phases
+class Profiler
+{
+public:
+  /// Returns the number of allocations made by the calling thread so far
+  using AllocationCounter = std::uint64_t (*)();
+
+  struct Event
+  {
+    std::string category;
+    std::string name;
+    std::uint32_t thread;
+    std::chrono::nanoseconds start;
+    std::chrono::nanoseconds wall_time;
+    std::chrono::nanoseconds cpu_time;
+    std::uint64_t allocations;
+  };
+
+  /// Measures the lifetime of the scope as a single event. Does nothing if the profiler is null.
+  class Scope
+  {
+public:
+    Scope(Profiler * profiler, const std::string & category, const std::string & name);
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+
+private:
+    Profiler * m_profiler;
+    Event m_event;
+  };
+
+  /// \param[in] allocation_counter Source of per-thread allocation counts, may be null
+  explicit Profiler(AllocationCounter allocation_counter = nullptr);
+
+  /// All recorded events in the order they finished
+  std::vector<Event> events() const;
+
+  /// Peak resident set size of the process in kilobytes
+  static long peak_rss_kb();
+
+  /// Write the events and a per-category summary as a human readable table
+  void write_table(std::ostream & os) const;
+
+  /// Write the events in the Chrome trace event format (chrome://tracing, Perfetto)
+  void write_chrome_trace(std::ostream & os) const;
+
+private:
+  void record(const Event & event);
+  std::uint32_t thread_index();
+  std::uint64_t allocations() const;
+  static std::chrono::nanoseconds thread_cpu_time();
+
+  AllocationCounter m_allocation_counter;
+  std::chrono::steady_clock::time_point m_start;
+
+  mutable std::mutex m_mutex;
+  std::vector<Event> m_events;
+  std::map<std::thread::id, std::uint32_t> m_threads;
+};
+
+}  // namespace DbcDriverGen
+
+#endif  // DBC_DRIVER_GEN__PROFILER_HPP_
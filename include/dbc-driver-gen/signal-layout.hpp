@@ -0,0 +1,121 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DBC_DRIVER_GEN__SIGNAL_LAYOUT_HPP_
+#define DBC_DRIVER_GEN__SIGNAL_LAYOUT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "dbc-driver-gen/third-party/inja.hpp"
+
+namespace DbcDriverGen
+{
+
+/// Largest payload of a CAN FD frame in bytes
+constexpr std::size_t MAX_FD_PAYLOAD_SIZE = 64U;
+
+/// The part of a signal stored in a single byte of the payload
+struct SignalSegment
+{
+  /// Index of the payload byte
+  uint32_t index;
+  /// Bits of the payload byte which belong to the signal
+  uint8_t mask;
+  /// Shift which moves the masked byte into place in the raw value. Positive values
+  /// shift left when decoding and right when encoding, negative values the opposite.
+  int32_t value_shift;
+};
+
+/// Split a signal into the payload bytes it occupies, in order of increasing byte index
+/// \param[in] start_bit Start bit as given in the DBC: the LSB for Intel, the MSB for Motorola
+/// \param[in] size Length of the signal in bits
+/// \param[in] is_bigendian Whether the signal uses Motorola byte order
+std::vector<SignalSegment> signal_segments(uint32_t start_bit, uint32_t size, bool is_bigendian);
+
+/// Number of bits of the smallest standard integer type which holds the given number of bits
+uint32_t container_bits(uint32_t bits);
+
+/// Name of the smallest fixed width unsigned integer type holding the given number of bits
+std::string unsigned_type(uint32_t bits);
+
+/// Name of the smallest fixed width signed integer type holding the given number of bits
+std::string signed_type(uint32_t bits);
+
+/// An unsigned C++ hexadecimal literal suitable for a value of the given width
+std::string hex_literal(uint64_t value, uint32_t bits);
+
+/// Length of the frame carrying a payload. Payloads above 8 bytes are padded to the next
+/// length a CAN FD data length code can express.
+/// \param[in] payload_size Length of the payload in bytes, at most MAX_FD_PAYLOAD_SIZE
+std::size_t frame_length(std::size_t payload_size);
+
+/// How the generated codecs represent the physical values of scaled signals
+enum class ValueRepresentation
+{
+  /// Every scaled signal is a double
+  DOUBLE,
+  /// Per signal, the first which fits: a FixedPoint integer with a decimal exponent when
+  /// factor and offset are decimal fractions, a float when the raw value fits the 24 bit
+  /// significand of a float, a double otherwise
+  FIXED_POINT,
+  /// Every signal keeps its raw value in the narrowest integer type, physical values are
+  /// computed by accessors
+  RAW
+};
+
+/// Most decimal places of a fixed-point value
+constexpr uint32_t MAX_FIXED_POINT_DIGITS = 9U;
+
+/// A scaling which maps raw values to integers, physical = (raw * scale + offset) * 10^exponent
+struct FixedPointScaling
+{
+  int32_t exponent;
+  int64_t scale;
+  int64_t offset;
+};
+
+/// The fixed-point scaling with the fewest decimal places which represents factor and offset
+/// exactly, if there is one with at most MAX_FIXED_POINT_DIGITS
+std::optional<FixedPointScaling> fixed_point_scaling(double factor, double offset);
+
+/// Add everything needed to decode and encode a signal with literal constants only
+/// \param[in,out] signal Signal description with start_bit, size, is_bigendian, is_signed,
+/// factor and offset
+/// \param[in] representation How the physical value of a scaled signal is represented
+void add_signal_layout(
+  inja::json & signal, ValueRepresentation representation = ValueRepresentation::DOUBLE);
+
+/// Order the members of a message struct: by decreasing size, so there is no padding between
+/// them, and signals with a receiver before those without one within each size. Adds
+/// field_order with the indices of the signals in member order and struct_size in bytes.
+/// \param[in,out] message Message with signals whose layout was added
+void add_struct_layout(inja::json & message);
+
+/// Smallest number of signals decoded together by a vector kernel
+constexpr std::size_t MIN_VECTOR_GROUP_SIZE = 4U;
+
+/// Find runs of signals which a vector kernel can decode together: consecutive Intel signals
+/// of 8 or 16 bits decoded to doubles, byte aligned and back to back, with the same sign,
+/// factor and offset. Every signal gets is_vector_lane, the first of each run starts_vector_group and
+/// vector_group with lane_type, byte_offset, count and the names of its members.
+/// \param[in,out] message Message with size and signals whose layout was added
+void add_vector_groups(inja::json & message);
+
+}  // namespace DbcDriverGen
+
+#endif  // DBC_DRIVER_GEN__SIGNAL_LAYOUT_HPP_
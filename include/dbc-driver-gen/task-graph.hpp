@@ -0,0 +1,70 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DBC_DRIVER_GEN__TASK_GRAPH_HPP_
+#define DBC_DRIVER_GEN__TASK_GRAPH_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace DbcDriverGen
+{
+
+/// A small dependency graph of tasks which is executed on a pool of worker threads.
+/// A task becomes runnable once all of the tasks it depends on have finished.
+class TaskGraph
+{
+public:
+  using TaskId = std::size_t;
+
+  /// Add a task to the graph
+  /// \param[in] phase The generation phase the task belongs to, used for reporting
+  /// \param[in] work The work to be done
+  /// \param[in] dependencies Tasks which must finish before this one starts
+  /// \return The identifier of the new task
+  TaskId add_task(
+    const std::string & phase,
+    std::function<void()> work,
+    const std::vector<TaskId> & dependencies = {});
+
+  /// Run every task in the graph and block until all have finished.
+  /// If a task throws, no new tasks are started and the first exception is rethrown.
+  /// \param[in] num_threads Number of worker threads, 0 selects the hardware concurrency
+  void run(std::size_t num_threads = 0);
+
+  /// Wall time spent in each phase, from the start of its first task to the end of its last
+  std::vector<std::pair<std::string, std::chrono::nanoseconds>> phase_durations() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Task
+  {
+    std::string phase;
+    std::function<void()> work;
+    std::vector<TaskId> dependents;
+    std::size_t num_dependencies{0U};
+    Clock::time_point start;
+    Clock::time_point end;
+  };
+
+  std::vector<Task> m_tasks;
+};
+
+}  // namespace DbcDriverGen
+
+#endif  // DBC_DRIVER_GEN__TASK_GRAPH_HPP_
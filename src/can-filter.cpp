@@ -0,0 +1,277 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dbc-driver-gen/can-filter.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <unordered_set>
+#include <utility>
+
+namespace DbcDriverGen
+{
+
+namespace
+{
+
+// SocketCAN CAN ID layout
+constexpr uint32_t EXTENDED_FLAG = 0x80000000U;
+constexpr uint32_t REMOTE_FLAG = 0x40000000U;
+constexpr uint32_t STANDARD_MASK = 0x7FFU;
+constexpr uint32_t EXTENDED_MASK = 0x1FFFFFFFU;
+
+/// Set of IDs agreeing with value in the bits of care
+struct Implicant
+{
+  uint32_t value;
+  uint32_t care;
+
+  bool covers(uint32_t id) const
+  {
+    return ((id ^ value) & care) == 0U;
+  }
+
+  bool covers(const Implicant & other) const
+  {
+    return (other.care & care) == care && (other.value & care) == value;
+  }
+};
+
+uint64_t implicant_key(uint32_t value, uint32_t care)
+{
+  return (static_cast<uint64_t>(care) << 32U) | value;
+}
+
+/// Implicants which cannot be merged any further, found by repeatedly merging pairs which
+/// differ in a single cared about bit
+std::vector<Implicant> prime_implicants(const std::vector<uint32_t> & ids, uint32_t width_mask)
+{
+  std::vector<Implicant> current;
+  std::vector<Implicant> primes;
+
+  for (const auto id : ids) {
+    current.push_back({id, width_mask});
+  }
+
+  while (!current.empty()) {
+    std::unordered_set<uint64_t> present;
+
+    for (const auto & implicant : current) {
+      present.insert(implicant_key(implicant.value, implicant.care));
+    }
+
+    std::vector<Implicant> next;
+    std::unordered_set<uint64_t> merged;
+
+    for (const auto & implicant : current) {
+      bool is_prime = true;
+
+      for (uint32_t bits = implicant.care; bits != 0U; bits &= bits - 1U) {
+        const uint32_t bit = bits & (~bits + 1U);
+
+        if (present.count(implicant_key(implicant.value ^ bit, implicant.care)) == 0U) {
+          continue;
+        }
+
+        is_prime = false;
+        const Implicant combined{implicant.value & ~bit, implicant.care & ~bit};
+
+        if (merged.insert(implicant_key(combined.value, combined.care)).second) {
+          next.push_back(combined);
+        }
+      }
+
+      if (is_prime) {
+        primes.push_back(implicant);
+      }
+    }
+
+    current = std::move(next);
+  }
+
+  return primes;
+}
+
+/// Pick prime implicants covering every ID: the essential ones first, then greedily the
+/// one covering the most IDs still uncovered
+std::vector<Implicant> cover(const std::vector<uint32_t> & ids, std::vector<Implicant> primes)
+{
+  std::sort(primes.begin(), primes.end(), [](const Implicant & a, const Implicant & b) {
+      return a.value != b.value ? a.value < b.value : a.care > b.care;
+    });
+
+  std::vector<std::vector<std::size_t>> covered_ids(primes.size());
+  std::vector<std::size_t> num_covering(ids.size(), 0U);
+  std::vector<std::size_t> only_prime(ids.size(), 0U);
+
+  for (std::size_t p = 0U; p < primes.size(); ++p) {
+    for (std::size_t i = 0U; i < ids.size(); ++i) {
+      if (primes[p].covers(ids[i])) {
+        covered_ids[p].push_back(i);
+        ++num_covering[i];
+        only_prime[i] = p;
+      }
+    }
+  }
+
+  std::vector<bool> chosen(primes.size(), false);
+  std::vector<bool> covered(ids.size(), false);
+  std::size_t num_uncovered = ids.size();
+
+  auto choose = [&](std::size_t p) {
+      chosen[p] = true;
+
+      for (const auto i : covered_ids[p]) {
+        if (!covered[i]) {
+          covered[i] = true;
+          --num_uncovered;
+        }
+      }
+    };
+
+  for (std::size_t i = 0U; i < ids.size(); ++i) {
+    if (num_covering[i] == 1U && !chosen[only_prime[i]]) {
+      choose(only_prime[i]);
+    }
+  }
+
+  while (num_uncovered > 0U) {
+    std::size_t best = 0U;
+    std::size_t best_count = 0U;
+
+    for (std::size_t p = 0U; p < primes.size(); ++p) {
+      if (chosen[p]) {
+        continue;
+      }
+
+      const auto count = static_cast<std::size_t>(std::count_if(
+          covered_ids[p].begin(), covered_ids[p].end(),
+          [&covered](std::size_t i) {return !covered[i];}));
+
+      if (count > best_count) {
+        best = p;
+        best_count = count;
+      }
+    }
+
+    choose(best);
+  }
+
+  std::vector<Implicant> result;
+
+  for (std::size_t p = 0U; p < primes.size(); ++p) {
+    if (chosen[p]) {
+      result.push_back(primes[p]);
+    }
+  }
+
+  return result;
+}
+
+/// A filter for standard or extended frames
+using Filter = std::pair<bool, Implicant>;
+
+bool filter_less(const Filter & a, const Filter & b)
+{
+  return a.first != b.first ? b.first : a.second.value < b.second.value;
+}
+
+/// Merge neighbouring filters into their smallest common superset until at most
+/// max_filters remain, or no two filters of the same format are left
+void merge_to_limit(std::vector<Filter> & filters, std::size_t max_filters)
+{
+  while (filters.size() > max_filters) {
+    std::size_t best = filters.size();
+    std::size_t best_free_bits = 0U;
+    Implicant merged{0U, 0U};
+
+    for (std::size_t i = 0U; i + 1U < filters.size(); ++i) {
+      if (filters[i].first != filters[i + 1U].first) {
+        continue;
+      }
+
+      const auto & a = filters[i].second;
+      const auto & b = filters[i + 1U].second;
+      const uint32_t care = a.care & b.care & ~(a.value ^ b.value);
+      const uint32_t width_mask = filters[i].first ? EXTENDED_MASK : STANDARD_MASK;
+      const std::size_t free_bits = std::bitset<32>(width_mask & ~care).count();
+
+      if (best == filters.size() || free_bits < best_free_bits) {
+        best = i;
+        best_free_bits = free_bits;
+        merged = {a.value & care, care};
+      }
+    }
+
+    if (best == filters.size()) {
+      return;
+    }
+
+    // The merged filter may pass everything other filters pass as well
+    const bool is_extended = filters[best].first;
+
+    filters.erase(std::remove_if(filters.begin(), filters.end(),
+      [is_extended, &merged](const Filter & filter) {
+        return filter.first == is_extended && merged.covers(filter.second);
+      }), filters.end());
+
+    filters.emplace_back(is_extended, merged);
+    std::sort(filters.begin(), filters.end(), filter_less);
+  }
+}
+
+}  // namespace
+
+std::vector<CanFilter> build_can_filters(
+  const std::vector<uint32_t> & keys, std::size_t max_filters)
+{
+  std::vector<uint32_t> standard_ids;
+  std::vector<uint32_t> extended_ids;
+  std::vector<uint32_t> unique_keys = keys;
+
+  std::sort(unique_keys.begin(), unique_keys.end());
+  unique_keys.erase(std::unique(unique_keys.begin(), unique_keys.end()), unique_keys.end());
+
+  for (const auto key : unique_keys) {
+    if ((key & EXTENDED_FLAG) != 0U) {
+      extended_ids.push_back(key & EXTENDED_MASK);
+    } else {
+      standard_ids.push_back(key & STANDARD_MASK);
+    }
+  }
+
+  std::vector<Filter> filters;
+
+  for (const auto & implicant : cover(standard_ids, prime_implicants(standard_ids, STANDARD_MASK))) {
+    filters.emplace_back(false, implicant);
+  }
+
+  for (const auto & implicant : cover(extended_ids, prime_implicants(extended_ids, EXTENDED_MASK))) {
+    filters.emplace_back(true, implicant);
+  }
+
+  merge_to_limit(filters, max_filters);
+
+  std::vector<CanFilter> result;
+
+  for (const auto & filter : filters) {
+    result.push_back({filter.second.value | (filter.first ? EXTENDED_FLAG : 0U),
+        filter.second.care | EXTENDED_FLAG | REMOTE_FLAG});
+  }
+
+  return result;
+}
+
+}  // namespace DbcDriverGen
@@ -0,0 +1,148 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dbc-driver-gen/dbc-attributes.hpp"
+
+#include <exception>
+#include <iomanip>
+#include <sstream>
+
+namespace DbcDriverGen
+{
+
+namespace
+{
+
+/// The rest of a statement without surrounding whitespace, the closing ';' and quotes
+std::string statement_value(std::istream & is)
+{
+  std::string value;
+  std::getline(is, value);
+
+  const auto first = value.find_first_not_of(" \t");
+  const auto last = value.find_last_not_of(" \t\r;");
+
+  if (first == std::string::npos || last < first) {
+    return "";
+  }
+
+  value = value.substr(first, last - first + 1U);
+
+  if (value.size() >= 2U && value.front() == '"' && value.back() == '"') {
+    value = value.substr(1U, value.size() - 2U);
+  }
+
+  return value;
+}
+
+/// The quoted, comma separated names of an ENUM definition
+std::vector<std::string> enum_names(std::istream & is)
+{
+  std::vector<std::string> names;
+  std::string name;
+  char separator;
+
+  while (is >> std::quoted(name)) {
+    names.push_back(name);
+
+    if (!(is >> separator) || separator != ',') {
+      break;
+    }
+  }
+
+  return names;
+}
+
+}  // namespace
+
+const std::string & MessageAttribute::value(uint32_t message_id) const
+{
+  const auto it = values.find(message_id);
+  return it == values.end() ? default_value : it->second;
+}
+
+std::string MessageAttribute::enum_value(uint32_t message_id) const
+{
+  const auto it = values.find(message_id);
+
+  if (it == values.end()) {
+    return default_value;
+  }
+
+  std::size_t parsed = 0U;
+  unsigned long index = 0U;
+
+  try {
+    index = std::stoul(it->second, &parsed);
+  } catch (const std::exception &) {
+    parsed = 0U;
+  }
+
+  // Not an index into the definition, keep the value as written
+  if (parsed == 0U || parsed != it->second.size() || index >= enum_values.size()) {
+    return it->second;
+  }
+
+  return enum_values[index];
+}
+
+MessageAttribute parse_message_attribute(
+  const std::vector<std::string> & lines, const std::string & name)
+{
+  MessageAttribute attribute;
+
+  for (const auto & line : lines) {
+    std::istringstream is(line);
+    std::string keyword;
+    std::string attribute_name;
+    std::string object_type;
+
+    if (!(is >> keyword)) {
+      continue;
+    }
+
+    if (keyword == "BA_DEF_") {
+      std::string type;
+
+      if (is >> object_type >> std::quoted(attribute_name) >> type && object_type == "BO_" &&
+        attribute_name == name && type == "ENUM")
+      {
+        attribute.enum_values = enum_names(is);
+      }
+
+      continue;
+    }
+
+    // Also skips the bare keywords listed in the NS_ section
+    if (!(is >> std::quoted(attribute_name)) || attribute_name != name) {
+      continue;
+    }
+
+    if (keyword == "BA_DEF_DEF_") {
+      attribute.default_value = statement_value(is);
+      continue;
+    }
+
+    uint32_t message_id;
+
+    if (keyword == "BA_" && is >> object_type >> message_id && object_type == "BO_") {
+      attribute.values[message_id] = statement_value(is);
+    }
+  }
+
+  return attribute;
+}
+
+}  // namespace DbcDriverGen
@@ -13,6 +13,11 @@
 // limitations under the License.
 
 #include "dbc-driver-gen/dbc-driver-gen.hpp"
+#include "dbc-driver-gen/can-filter.hpp"
+#include "dbc-driver-gen/dbc-attributes.hpp"
+#include "dbc-driver-gen/dispatch-table.hpp"
+#include "dbc-driver-gen/signal-layout.hpp"
+#include "dbc-driver-gen/task-graph.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -20,7 +25,11 @@
 #include <ctime>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
 #include <string>
 #include <system_error>
 
@@ -32,11 +41,14 @@ namespace DbcDriverGen
 DbcDriverGenerator::DbcDriverGenerator(
   const std::string & dbc_path,
   const std::string & copyright_holder,
-  const std::string & project_name)
+  const std::string & project_name,
+  Profiler * profiler)
 : m_project_name_snake(project_name),
   m_project_name_camel(project_name),
   m_project_name_upper(project_name),
-  m_project_name_lower(project_name)
+  m_project_name_lower(project_name),
+  m_log(&std::cout),
+  m_profiler(profiler)
 {
   std::filesystem::path dbc_file_path(dbc_path);
 
@@ -62,8 +74,41 @@ DbcDriverGenerator::DbcDriverGenerator(
     dbc_file_path = std::filesystem::absolute(dbc_file_path);
   }
 
+  m_dbc_path = dbc_file_path;
+
   std::ifstream file(dbc_file_path);
-  m_parser.parse_file(file);
+  init(file, copyright_holder);
+}
+
+DbcDriverGenerator::DbcDriverGenerator(
+  std::istream & dbc_stream,
+  const std::string & copyright_holder,
+  const std::string & project_name,
+  Profiler * profiler)
+: m_project_name_snake(project_name),
+  m_project_name_camel(project_name),
+  m_project_name_upper(project_name),
+  m_project_name_lower(project_name),
+  m_log(&std::cout),
+  m_profiler(profiler)
+{
+  init(dbc_stream, copyright_holder);
+}
+
+void DbcDriverGenerator::init(std::istream & dbc_stream, const std::string & copyright_holder)
+{
+  m_inja_env.set_trim_blocks(true);
+  m_inja_env.set_lstrip_blocks(true);
+
+  auto parse_start = std::chrono::steady_clock::now();
+
+  {
+    Profiler::Scope scope(m_profiler, "parse dbc", "DbcParser::parse_file");
+    m_parser.parse_file(dbc_stream);
+  }
+
+  m_parse_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - parse_start);
 
   // Get different versions of project_name
   std::transform(m_project_name_upper.begin(), m_project_name_upper.end(),
@@ -89,14 +134,228 @@ DbcDriverGenerator::DbcDriverGenerator(
   m_common_json["projectname"]["lower"] = m_project_name_lower;
   m_common_json["copyright"] = generate_copyright(copyright_holder);
 
+  Profiler::Scope scope(m_profiler, "build model", "generate_dbc_json");
   generate_dbc_json();
 }
 
 void DbcDriverGenerator::generate_dbc_json()
 {
-  // Loop through each message in the DBC and generate some stuff
-  for (const auto & msg : m_parser.get_messages()) {
+  m_messages = m_parser.get_messages();
+
+  // Only a compact summary of each message is kept for the whole generation. The full
+  // description including signals is built on demand by message_json() while rendering.
+  m_dbc_json = m_common_json;
+  m_dbc_json["messages"] = inja::json::array();
+
+  // Cyclic messages are sent by the generated scheduler at their GenMsgCycleTime
+  const auto cycle_times = parse_message_attribute(m_parser.unused_lines(), "GenMsgCycleTime");
+  m_cycle_times.clear();
+
+  for (const auto & message : m_messages) {
+    const std::string & value = cycle_times.value(message.id());
+    std::size_t parsed = 0U;
+    long cycle_time = 0;
+
+    try {
+      cycle_time = value.empty() ? 0 : std::stol(value, &parsed);
+    } catch (const std::exception &) {
+      parsed = std::string::npos;
+    }
+
+    if ((!value.empty() && parsed != value.size()) || cycle_time < 0) {
+      auto fsec = std::make_error_code(std::errc::invalid_argument);
+      std::filesystem::filesystem_error fe(
+        "Message " + message.name() + " has an invalid GenMsgCycleTime: " + value, fsec);
+      throw fe;
+    }
+
+    m_cycle_times.push_back(static_cast<uint32_t>(cycle_time));
+  }
+
+  // Messages above 8 bytes and those with a CAN FD VFrameFormat are sent as CAN FD frames,
+  // switching the bit rate for the payload unless CANFD_BRS is 0
+  constexpr uint8_t FD_BIT_RATE_SWITCH = 0x01U;
+  constexpr uint8_t FD_FRAME = 0x04U;
+  const auto frame_formats = parse_message_attribute(m_parser.unused_lines(), "VFrameFormat");
+  const auto bit_rate_switches = parse_message_attribute(m_parser.unused_lines(), "CANFD_BRS");
+  m_fd_flags.clear();
+
+  for (const auto & message : m_messages) {
+    if (message.size() > MAX_FD_PAYLOAD_SIZE) {
+      auto fsec = std::make_error_code(std::errc::invalid_argument);
+      std::filesystem::filesystem_error fe(
+        "Message " + message.name() + " is larger than a CAN FD frame: " +
+        std::to_string(message.size()) + " bytes", fsec);
+      throw fe;
+    }
+
+    const std::string format = frame_formats.enum_value(message.id());
+    const bool is_fd = message.size() > 8U ||
+      (format.size() > 3U && format.compare(format.size() - 3U, 3U, "_FD") == 0);
+    const bool switches_bit_rate = bit_rate_switches.enum_value(message.id()) != "0";
+
+    m_fd_flags.push_back(is_fd ?
+      static_cast<uint8_t>(FD_FRAME | (switches_bit_rate ? FD_BIT_RATE_SWITCH : 0U)) : 0U);
+  }
+
+  std::size_t max_message_size = 0U;
+  std::size_t num_cyclic_messages = 0U;
+
+  for (std::size_t i = 0U; i < m_messages.size(); ++i) {
+    m_dbc_json["messages"].push_back(message_summary_json(m_messages[i], i));
+    max_message_size = std::max<std::size_t>(max_message_size, m_messages[i].size());
+
+    if (m_dbc_json["messages"].back()["is_cyclic"].get<bool>()) {
+      ++num_cyclic_messages;
+    }
+  }
+
+  m_dbc_json["max_message_size"] = max_message_size;
+  m_dbc_json["num_cyclic_messages"] = num_cyclic_messages;
+
+  // Frames are routed to their decoder by a lookup table computed here
+  std::vector<uint32_t> keys;
+  std::set<uint32_t> unique_keys;
+
+  for (const auto & message : m_dbc_json["messages"]) {
+    const uint32_t key = message["dispatch_key"];
+
+    if (!unique_keys.insert(key).second) {
+      auto fsec = std::make_error_code(std::errc::invalid_argument);
+      std::filesystem::filesystem_error fe(
+        "Message " + message["name"].get<std::string>() + " reuses the CAN ID " +
+        message["id_hex"].get<std::string>() + " of another message.", fsec);
+      throw fe;
+    }
+
+    keys.push_back(key);
+  }
+
+  const auto table = build_dispatch_table(keys);
+
+  auto & dispatch = m_dbc_json["dispatch"];
+  dispatch["is_direct"] = table.is_direct;
+  dispatch["num_buckets"] = table.num_buckets;
+  dispatch["displacements"] = table.displacements;
+
+  // Kernel receive filters for all messages, and for the messages each node receives
+  m_dbc_json["filters"] = filters_json(keys);
+  m_dbc_json["nodes"] = inja::json::array();
+
+  for (const auto & node : m_parser.get_nodes()) {
+    std::vector<uint32_t> node_keys;
+
+    for (std::size_t i = 0U; i < m_messages.size(); ++i) {
+      const auto signals = m_messages[i].get_signals();
+      const bool is_received = std::any_of(signals.begin(), signals.end(),
+        [&node](const Libdbc::Signal & sig) {
+          return std::find(sig.receivers.begin(), sig.receivers.end(), node) !=
+          sig.receivers.end();
+        });
+
+      if (is_received) {
+        node_keys.push_back(keys[i]);
+      }
+    }
+
+    inja::json node_json;
+    node_json["name"] = node;
+    node_json["filters"] = filters_json(node_keys);
+    m_dbc_json["nodes"].push_back(std::move(node_json));
+  }
+}
+
+inja::json DbcDriverGenerator::filters_json(const std::vector<uint32_t> & keys)
+{
+  inja::json filters = inja::json::array();
+
+  // Written as C++ initializer lists of struct can_filter
+  for (const auto & filter : build_can_filters(keys)) {
+    filters.push_back(
+      "{" + hex_literal(filter.id, 32U) + ", " + hex_literal(filter.mask, 32U) + "}");
+  }
+
+  return filters;
+}
+
+inja::json DbcDriverGenerator::message_summary_json(
+  const Message & msg, std::size_t index) const
+{
+  // The DBC marks extended identifiers with bit 31, just like SocketCAN's CAN_EFF_FLAG
+  constexpr uint32_t EXTENDED_FLAG = 0x80000000U;
+  constexpr uint32_t EXTENDED_MASK = 0x1FFFFFFFU;
+
+  std::ostringstream id_hex;
+  id_hex << "0x" << std::uppercase << std::hex << (msg.id() & EXTENDED_MASK) << "U";
+
+  inja::json summary;
+  summary["name"] = msg.name();
+  summary["index"] = index;
+  summary["id"] = msg.id() & EXTENDED_MASK;
+  summary["id_hex"] = id_hex.str();
+  summary["raw_id"] = msg.id();
+  summary["is_extended"] = (msg.id() & EXTENDED_FLAG) != 0U;
+  summary["dispatch_key"] = msg.id() & (EXTENDED_FLAG | EXTENDED_MASK);
+  summary["size"] = msg.size();
+  summary["num_signals"] = msg.get_signals().size();
+
+  // Payload bits covered by signals, written as a C++ initializer list
+  std::vector<uint8_t> signal_mask(msg.size(), 0U);
+
+  for (const auto & sig : msg.get_signals()) {
+    for (const auto & segment : signal_segments(sig.start_bit, sig.size, sig.is_bigendian)) {
+      if (segment.index < signal_mask.size()) {
+        signal_mask[segment.index] |= segment.mask;
+      }
+    }
+  }
+
+  std::ostringstream mask;
+  mask << "{";
+
+  for (std::size_t i = 0U; i < signal_mask.size(); ++i) {
+    mask << (i == 0U ? "" : ", ") << hex_literal(signal_mask[i], 8U);
+  }
+
+  mask << "}";
+  summary["signal_mask"] = mask.str();
+  summary["cycle_time_ms"] = m_cycle_times[index];
+  summary["is_cyclic"] = m_cycle_times[index] > 0U;
+  summary["is_fd"] = m_fd_flags[index] != 0U;
+  summary["fd_flags"] = hex_literal(m_fd_flags[index], 8U);
+  summary["frame_length"] = frame_length(msg.size());
+
+  return summary;
+}
+
+inja::json DbcDriverGenerator::message_json(const Message & msg, std::size_t index) const
+{
+  auto message = message_summary_json(msg, index);
+  message["signals"] = inja::json::array();
+
+  for (const auto & sig : msg.get_signals()) {
+    inja::json signal;
+    signal["name"] = sig.name;
+    signal["start_bit"] = sig.start_bit;
+    signal["size"] = sig.size;
+    signal["is_bigendian"] = sig.is_bigendian;
+    signal["is_signed"] = sig.is_signed;
+    signal["factor"] = sig.factor;
+    signal["offset"] = sig.offset;
+    signal["min"] = sig.min;
+    signal["max"] = sig.max;
+    signal["unit"] = sig.unit;
+    signal["receivers"] = sig.receivers;
+
+    add_signal_layout(signal, m_value_representation);
+
+    message["signals"].push_back(std::move(signal));
   }
+
+  add_struct_layout(message);
+  add_vector_groups(message);
+
+  return message;
 }
 
 void DbcDriverGenerator::generate_driver(
@@ -127,6 +386,92 @@ void DbcDriverGenerator::generate_driver(
     output_folder = std::filesystem::absolute(output_folder);
   }
   
+  DirectorySink sink(output_folder / m_project_name_lower, m_profiler);
+
+  generate_driver(templates_path, sink);
+
+  if (m_log != nullptr) {
+    *m_log << "Done! Driver generated in: " << sink.root_folder() << std::endl;
+  }
+}
+
+void DbcDriverGenerator::generate_driver(const std::string & templates_path, OutputSink & sink)
+{
+  auto templates_folder = check_templates_folder(templates_path);
+
+  std::filesystem::path header_output_folder = std::filesystem::path("include") / m_project_name_lower;
+  std::filesystem::path source_output_folder = "src";
+
+  std::vector<OutputFile> outputs;
+
+  generate_header_files(header_output_folder, templates_folder, outputs);
+  generate_source_files(source_output_folder, templates_folder, outputs);
+  generate_benchmark_files("bench", templates_folder, outputs);
+  generate_cmake("", templates_folder, outputs);
+
+  m_input_files.clear();
+  for (const auto & output : outputs) {
+    m_input_files.push_back(output.template_file);
+  }
+
+  if (m_log != nullptr) {
+    *m_log << "Generating " << outputs.size() << " files..." << std::endl;
+  }
+
+  render_outputs(outputs, sink);
+
+  log_phase_durations();
+}
+
+GeneratedFiles DbcDriverGenerator::generate_driver_files(const std::string & templates_path)
+{
+  MemorySink sink;
+  generate_driver(templates_path, sink);
+  return sink.take_files();
+}
+
+void DbcDriverGenerator::write_depfile(
+  const std::filesystem::path & depfile_path,
+  const std::filesystem::path & target) const
+{
+  // Make syntax needs spaces, '#' and '$' escaped in file names
+  auto escape = [](const std::filesystem::path & path) {
+      std::string escaped;
+      for (const char c : path.string()) {
+        if (c == ' ' || c == '#') {
+          escaped += '\\';
+        } else if (c == '$') {
+          escaped += '$';
+        }
+        escaped += c;
+      }
+      return escaped;
+    };
+
+  std::ofstream depfile(depfile_path);
+
+  depfile << escape(target) << ":";
+
+  if (!m_dbc_path.empty()) {
+    depfile << " \\\n  " << escape(m_dbc_path);
+  }
+
+  for (const auto & input : m_input_files) {
+    depfile << " \\\n  " << escape(input);
+  }
+
+  depfile << std::endl;
+
+  if (!depfile) {
+    auto fsec = std::make_error_code(std::errc::io_error);
+    std::filesystem::filesystem_error
+      fe{"Failed writing dependency file.", depfile_path, fsec};
+    throw fe;
+  }
+}
+
+std::filesystem::path DbcDriverGenerator::check_templates_folder(const std::string & templates_path)
+{
   // Test templates path
   auto templates_folder = std::filesystem::path(templates_path) / "driver";
 
@@ -152,30 +497,118 @@ void DbcDriverGenerator::generate_driver(
     templates_folder = std::filesystem::absolute(templates_folder);
   }
 
-  std::cout << "Creating directories..." << std::endl;
+  return templates_folder;
+}
 
-  std::filesystem::path base_output_folder = output_folder / m_project_name_lower;
+void DbcDriverGenerator::log_phase_durations()
+{
+  if (m_log == nullptr) {
+    return;
+  }
 
-  std::filesystem::path header_output_folder =
-    base_output_folder / "include" / m_project_name_lower;
-  std::filesystem::create_directories(header_output_folder);
+  *m_log << "Generation time by phase:" << std::endl;
 
-  std::filesystem::path source_output_folder = base_output_folder / "src";
-  std::filesystem::create_directories(source_output_folder);
+  for (const auto & phase : m_phase_durations) {
+    *m_log << "  " << std::left << std::setw(20) << phase.first << std::right <<
+      std::fixed << std::setprecision(3) << std::setw(10) <<
+      std::chrono::duration<double, std::milli>(phase.second).count() << " ms" << std::endl;
+  }
+}
 
-  std::cout << "Generating header files..." << std::endl;
+void DbcDriverGenerator::render_outputs(
+  const std::vector<OutputFile> & outputs, OutputSink & sink)
+{
+  TaskGraph graph;
+
+  // inja::Environment is not safe for concurrent parsing, so all templates are parsed
+  // by a single task. Rendering only reads the parsed templates and can run in parallel.
+  std::vector<inja::Template> templates(outputs.size());
+
+  auto parse_task = graph.add_task("parse templates",
+    [this, &outputs, &templates]() {
+      for (std::size_t i = 0; i < outputs.size(); ++i) {
+        if (outputs[i].data != nullptr) {
+          Profiler::Scope scope(m_profiler, "parse template",
+            outputs[i].template_file.filename().string());
+          templates[i] = m_inja_env.parse_template(outputs[i].template_file);
+        }
+      }
+    });
+
+  // Templates are rendered straight into the sink, so independent outputs are rendered
+  // and written concurrently without holding their content in memory. Files copied
+  // verbatim are read by one task and handed to the sink by another.
+  std::vector<std::string> contents(outputs.size());
+
+  for (std::size_t i = 0; i < outputs.size(); ++i) {
+    const auto & output = outputs[i];
+
+    if (output.data != nullptr) {
+      graph.add_task("render templates",
+        [this, &output, &templates, &sink, i]() {
+          // The sink records writing the file after rendering as an event of its own
+          sink.write_stream(output.output_file,
+            [this, &output, &templates, i](std::ostream & os) {
+              Profiler::Scope scope(m_profiler, "render",
+                output.template_file.filename().string());
+              render_output(output, templates[i], os);
+            });
+        }, {parse_task});
+      continue;
+    }
 
-  generate_header_files(header_output_folder, templates_folder);
+    auto read_task = graph.add_task("read files",
+      [this, &output, &contents, i]() {
+        Profiler::Scope scope(m_profiler, "read file", output.template_file.filename().string());
+
+        std::ifstream file(output.template_file, std::ios::binary);
+        contents[i].assign(
+          std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        if (!file.is_open() || file.bad()) {
+          auto fsec = std::make_error_code(std::errc::io_error);
+          std::filesystem::filesystem_error
+            fe{"Failed reading template file.", output.template_file, fsec};
+          throw fe;
+        }
+      });
+
+    graph.add_task("write files",
+      [this, &output, &contents, &sink, i]() {
+        Profiler::Scope scope(m_profiler, "write file", output.output_file.string());
+        sink.write(output.output_file, contents[i]);
+      }, {read_task});
+  }
+
+  graph.run();
 
-  std::cout << "Generating source files..." << std::endl;
+  m_phase_durations = graph.phase_durations();
+  m_phase_durations.insert(m_phase_durations.begin(), {"parse dbc", m_parse_duration});
+}
 
-  generate_source_files(source_output_folder, templates_folder);
+void DbcDriverGenerator::render_output(
+  const OutputFile & output, const inja::Template & tmpl, std::ostream & os)
+{
+  if (!output.per_message) {
+    m_inja_env.render_to(os, tmpl, *output.data);
+    return;
+  }
 
-  std::cout << "Generating CMake file..." << std::endl;
+  // Only the description of the message currently being rendered is held in memory
+  inja::json data = *output.data;
 
-  generate_cmake(base_output_folder, templates_folder);
+  data["pass"] = "head";
+  m_inja_env.render_to(os, tmpl, data);
 
-  std::cout << "Done! Driver generated in: " << base_output_folder << std::endl;
+  data["pass"] = "message";
+  for (std::size_t i = 0U; i < m_messages.size(); ++i) {
+    data["message"] = message_json(m_messages[i], i);
+    m_inja_env.render_to(os, tmpl, data);
+  }
+
+  data.erase("message");
+  data["pass"] = "tail";
+  m_inja_env.render_to(os, tmpl, data);
 }
 
 std::string DbcDriverGenerator::generate_copyright(const std::string & copyright_holder)
@@ -194,71 +627,158 @@ std::string DbcDriverGenerator::generate_copyright(const std::string & copyright
 
 void DbcDriverGenerator::generate_header_files(
   const std::filesystem::path & output_folder,
-  const std::filesystem::path & templates_folder
+  const std::filesystem::path & templates_folder,
+  std::vector<OutputFile> & outputs
 )
 {
   // Common headers
-  std::filesystem::path output_file = output_folder / "visibility_control.hpp";
-  std::filesystem::path template_file = templates_folder / "visibility_control.hpp.inja";
-
-  m_inja_env.write(template_file, m_common_json, output_file);
+  outputs.push_back({templates_folder / "visibility_control.hpp.inja",
+    output_folder / "visibility_control.hpp", &m_common_json, false});
 
   // SocketCAN headers
-  output_file = output_folder / "socket_can_common.hpp";
-  template_file = templates_folder / "socket_can_common.hpp.inja";
+  outputs.push_back({templates_folder / "socket_can_bcm.hpp.inja",
+    output_folder / "socket_can_bcm.hpp", &m_common_json, false});
 
-  m_inja_env.write(template_file, m_common_json, output_file);
+  outputs.push_back({templates_folder / "socket_can_common.hpp.inja",
+    output_folder / "socket_can_common.hpp", &m_common_json, false});
 
-  output_file = output_folder / "socket_can_id.hpp";
-  template_file = templates_folder / "socket_can_id.hpp.inja";
+  outputs.push_back({templates_folder / "socket_can_id.hpp.inja",
+    output_folder / "socket_can_id.hpp", &m_common_json, false});
 
-  m_inja_env.write(template_file, m_common_json, output_file);
+  outputs.push_back({templates_folder / "socket_can_event_loop.hpp.inja",
+    output_folder / "socket_can_event_loop.hpp", &m_common_json, false});
 
-  // DBC header
-  output_file = output_folder / (m_project_name_snake + "_dbc.hpp");
-  template_file = templates_folder / "dbc.hpp.inja";
+  outputs.push_back({templates_folder / "socket_can_receiver.hpp.inja",
+    output_folder / "socket_can_receiver.hpp", &m_common_json, false});
 
-  // TODO: Merge m_common_json with m_dbc_json
+  outputs.push_back({templates_folder / "socket_can_scheduler.hpp.inja",
+    output_folder / "socket_can_scheduler.hpp", &m_common_json, false});
 
-  m_inja_env.write(template_file, m_common_json, output_file);
+  outputs.push_back({templates_folder / "socket_can_uring.hpp.inja",
+    output_folder / "socket_can_uring.hpp", &m_common_json, false});
+
+  // Latest value store
+  outputs.push_back({templates_folder / "seqlock.hpp.inja",
+    output_folder / "seqlock.hpp", &m_common_json, false});
+
+  // Change detection
+  outputs.push_back({templates_folder / "change_detector.hpp.inja",
+    output_folder / "change_detector.hpp", &m_common_json, false});
+
+  // Signal decoding
+  outputs.push_back({templates_folder / "fixed_point.hpp.inja",
+    output_folder / "fixed_point.hpp", &m_common_json, false});
+  outputs.push_back({templates_folder / "vector_decode.hpp.inja",
+    output_folder / "vector_decode.hpp", &m_common_json, false});
+
+  // Queues between threads
+  outputs.push_back({templates_folder / "frame_queue.hpp.inja",
+    output_folder / "frame_queue.hpp", &m_common_json, false});
+
+  // Transmit scheduling
+  outputs.push_back({templates_folder / "timer_wheel.hpp.inja",
+    output_folder / "timer_wheel.hpp", &m_common_json, false});
+
+  // DBC header
+  outputs.push_back({templates_folder / "dbc.hpp.inja",
+    output_folder / (m_project_name_snake + "_dbc.hpp"), &m_dbc_json, true});
 
   // Driver header
-  output_file = output_folder / (m_project_name_snake + "_driver.hpp");
-  template_file = templates_folder / "driver.hpp.inja";
+  outputs.push_back({templates_folder / "driver.hpp.inja",
+    output_folder / (m_project_name_snake + "_driver.hpp"), &m_dbc_json, false});
 
-  // TODO: Merge m_common_json with driver_header_json
+  // Typed callbacks
+  outputs.push_back({templates_folder / "callbacks.hpp.inja",
+    output_folder / (m_project_name_snake + "_callbacks.hpp"), &m_dbc_json, false});
 
-  m_inja_env.write(template_file, m_common_json, output_file);
+  // Driver receiving from several buses
+  outputs.push_back({templates_folder / "multi_bus_driver.hpp.inja",
+    output_folder / (m_project_name_snake + "_multi_bus_driver.hpp"), &m_dbc_json, false});
 }
 
 void DbcDriverGenerator::generate_source_files(
   const std::filesystem::path & output_folder,
-  const std::filesystem::path & templates_folder
+  const std::filesystem::path & templates_folder,
+  std::vector<OutputFile> & outputs
 )
 {
-  // Driver source file
-  std::filesystem::path output_file = output_folder / (m_project_name_snake + "_driver.cpp");
-  std::filesystem::path template_file = templates_folder / "driver.cpp.inja";
+  // SocketCAN source files
+  outputs.push_back({templates_folder / "socket_can_bcm.cpp.inja",
+    output_folder / "socket_can_bcm.cpp", &m_common_json, false});
+
+  outputs.push_back({templates_folder / "socket_can_common.cpp.inja",
+    output_folder / "socket_can_common.cpp", &m_common_json, false});
 
-  // TODO: Merge m_common_json with driver_source_json
+  outputs.push_back({templates_folder / "socket_can_event_loop.cpp.inja",
+    output_folder / "socket_can_event_loop.cpp", &m_common_json, false});
 
-  m_inja_env.write(template_file, m_common_json, output_file);
+  outputs.push_back({templates_folder / "socket_can_id.cpp.inja",
+    output_folder / "socket_can_id.cpp", &m_common_json, false});
+
+  outputs.push_back({templates_folder / "socket_can_receiver.cpp.inja",
+    output_folder / "socket_can_receiver.cpp", &m_common_json, false});
+
+  outputs.push_back({templates_folder / "socket_can_scheduler.cpp.inja",
+    output_folder / "socket_can_scheduler.cpp", &m_common_json, false});
+
+  outputs.push_back({templates_folder / "timer_wheel.cpp.inja",
+    output_folder / "timer_wheel.cpp", &m_common_json, false});
+
+  // Only compiled when the driver is configured with the io_uring backend
+  outputs.push_back({templates_folder / "socket_can_uring.cpp.inja",
+    output_folder / "socket_can_uring.cpp", &m_common_json, false});
+
+  // Driver source file
+  outputs.push_back({templates_folder / "driver.cpp.inja",
+    output_folder / (m_project_name_snake + "_driver.cpp"), &m_dbc_json, false});
+
+  // Driver receiving from several buses
+  outputs.push_back({templates_folder / "multi_bus_driver.cpp.inja",
+    output_folder / (m_project_name_snake + "_multi_bus_driver.cpp"), &m_dbc_json, false});
 }
 
-void DbcDriverGenerator::generate_cmake(
+void DbcDriverGenerator::generate_benchmark_files(
   const std::filesystem::path & output_folder,
-  const std::filesystem::path & templates_folder
+  const std::filesystem::path & templates_folder,
+  std::vector<OutputFile> & outputs
 )
 {
-  std::filesystem::path output_file = output_folder / "CMakeLists.txt";
-  std::filesystem::path template_file = templates_folder / "CMakeLists.txt.inja";
+  // Generated decoders compared against libdbc
+  outputs.push_back({templates_folder / "dbc_benchmark.cpp.inja",
+    output_folder / (m_project_name_snake + "_dbc_benchmark.cpp"), &m_dbc_json, true});
+
+  // Latest value store under contention
+  outputs.push_back({templates_folder / "latest_value_benchmark.cpp.inja",
+    output_folder / (m_project_name_snake + "_latest_value_benchmark.cpp"), &m_dbc_json, false});
 
-  // TODO: Merge m_common_json with driver_source_json
+  // Typed callbacks compared against std::function and virtual dispatch
+  outputs.push_back({templates_folder / "callbacks_benchmark.cpp.inja",
+    output_folder / (m_project_name_snake + "_callbacks_benchmark.cpp"), &m_dbc_json, false});
 
-  m_inja_env.write(template_file, m_common_json, output_file);
+  // Frame queues under contention
+  outputs.push_back({templates_folder / "queue_benchmark.cpp.inja",
+    output_folder / (m_project_name_snake + "_queue_benchmark.cpp"), &m_common_json, false});
+
+  // Batched receiving on a live interface
+  outputs.push_back({templates_folder / "rx_benchmark.cpp.inja",
+    output_folder / (m_project_name_snake + "_rx_benchmark.cpp"), &m_dbc_json, false});
+
+  // Cyclic transmit scheduling on a live interface
+  outputs.push_back({templates_folder / "tx_benchmark.cpp.inja",
+    output_folder / (m_project_name_snake + "_tx_benchmark.cpp"), &m_dbc_json, false});
+}
+
+void DbcDriverGenerator::generate_cmake(
+  const std::filesystem::path & output_folder,
+  const std::filesystem::path & templates_folder,
+  std::vector<OutputFile> & outputs
+)
+{
+  outputs.push_back({templates_folder / "CMakeLists.txt.inja",
+    output_folder / "CMakeLists.txt", &m_common_json, false});
 
   // Copy uninstall template
-  std::filesystem::path uninstall_file = templates_folder / "cmake_uninstall.cmake.in";
-  std::filesystem::copy(uninstall_file, output_folder);
+  outputs.push_back({templates_folder / "cmake_uninstall.cmake.in",
+    output_folder / "cmake_uninstall.cmake.in", nullptr, false});
 }
 }  // namespace DbcDriverGen
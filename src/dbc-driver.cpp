@@ -15,10 +15,55 @@
 #include "dbc-driver-gen/dbc-driver-gen.hpp"
 #include "dbc-driver-gen/third-party/cxxopts.hpp"
 
+#include <cstdint>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <new>
 
 using DbcDriverGen::DbcDriverGenerator;
+using DbcDriverGen::Profiler;
+
+namespace
+{
+
+// Every allocation in the process, including those made inside the generator library,
+// goes through the replaced global operator new below. Allocations are only counted per
+// thread once --profile set the flag, which happens before any worker thread starts.
+bool g_count_allocations = false;
+thread_local std::uint64_t t_allocations = 0U;
+
+std::uint64_t thread_allocations()
+{
+  return t_allocations;
+}
+
+}  // namespace
+
+void * operator new(std::size_t size)
+{
+  if (g_count_allocations) {
+    ++t_allocations;
+  }
+
+  if (void * ptr = std::malloc(size == 0U ? 1U : size)) {
+    return ptr;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
 
 int main(int argc, char * argv[])
 {
@@ -29,7 +74,13 @@ int main(int argc, char * argv[])
     ("copyright_holder", "The person or company that holds the copyright for the generated code.", cxxopts::value<std::string>())
     ("project_name", "The name for the project - must be in snake_case.", cxxopts::value<std::string>())
     ("output_path", "The output directory for the generated files.", cxxopts::value<std::string>())
-    ("templates_path", "The directory containing the Inja template files.", cxxopts::value<std::string>()->default_value("/usr/local/share/dbc-driver-gen/templates"));
+    ("templates_path", "The directory containing the Inja template files.", cxxopts::value<std::string>()->default_value("/usr/local/share/dbc-driver-gen/templates"))
+    ("quiet", "Do not print progress messages.")
+    ("values", "Physical values of scaled signals: double, fixed_point for fixed-point integers or float where they suffice, or raw for raw integers with physical accessors.", cxxopts::value<std::string>()->default_value("double"))
+    ("depfile", "Write a Makefile style dependency file listing the DBC and templates used.", cxxopts::value<std::string>())
+    ("stamp", "Touch this file after successful generation. Used as the target of the dependency file.", cxxopts::value<std::string>())
+    ("profile", "Print wall time, CPU time and allocations of every generation phase and write a Chrome trace.")
+    ("profile_trace", "The Chrome trace file written when profiling.", cxxopts::value<std::string>()->default_value("dbc-driver-profile.json"));
 
   options.parse_positional({"dbc_file", "copyright_holder", "project_name", "output_path"});
   options.positional_help("dbc_file copyright_holder project_name output_path");
@@ -47,15 +98,70 @@ int main(int argc, char * argv[])
     exit(-1);
   }
 
+  const std::string values = parsed_opts["values"].as<std::string>();
+
+  if (values != "double" && values != "fixed_point" && values != "raw") {
+    std::cout << "\nUnknown value representation: " << values << "\n\n";
+    std::cout << options.help() << std::endl;
+    exit(-1);
+  }
+
+  std::unique_ptr<Profiler> profiler;
+
+  if (parsed_opts.count("profile")) {
+    g_count_allocations = true;
+    profiler = std::make_unique<Profiler>(&thread_allocations);
+  }
+
   DbcDriverGenerator dbc_gen(
     parsed_opts["dbc_file"].as<std::string>(),
     parsed_opts["copyright_holder"].as<std::string>(),
-    parsed_opts["project_name"].as<std::string>()
+    parsed_opts["project_name"].as<std::string>(),
+    profiler.get()
   );
 
-  std::cout << "DBC parsed. Generating driver..." << std::endl;
+  if (values == "fixed_point") {
+    dbc_gen.set_value_representation(DbcDriverGen::ValueRepresentation::FIXED_POINT);
+  } else if (values == "raw") {
+    dbc_gen.set_value_representation(DbcDriverGen::ValueRepresentation::RAW);
+  }
+
+  if (parsed_opts.count("quiet")) {
+    dbc_gen.set_log_stream(nullptr);
+  } else {
+    std::cout << "DBC parsed. Generating driver..." << std::endl;
+  }
 
   dbc_gen.generate_driver(parsed_opts["output_path"].as<std::string>(), parsed_opts["templates_path"].as<std::string>());
 
+  std::filesystem::path stamp_file;
+
+  if (parsed_opts.count("stamp")) {
+    stamp_file = std::filesystem::absolute(parsed_opts["stamp"].as<std::string>());
+    std::ofstream stamp(stamp_file, std::ios::trunc);
+  }
+
+  if (parsed_opts.count("depfile")) {
+    std::filesystem::path depfile = parsed_opts["depfile"].as<std::string>();
+
+    if (stamp_file.empty()) {
+      stamp_file = std::filesystem::absolute(parsed_opts["output_path"].as<std::string>());
+    }
+
+    dbc_gen.write_depfile(depfile, stamp_file);
+  }
+
+  if (profiler) {
+    std::filesystem::path trace_file = parsed_opts["profile_trace"].as<std::string>();
+
+    std::cout << std::endl;
+    profiler->write_table(std::cout);
+
+    std::ofstream trace(trace_file);
+    profiler->write_chrome_trace(trace);
+
+    std::cout << "Chrome trace written to: " << trace_file << std::endl;
+  }
+
   return 0;
 }
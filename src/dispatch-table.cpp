@@ -0,0 +1,116 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dbc-driver-gen/dispatch-table.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace DbcDriverGen
+{
+
+namespace
+{
+
+/// Try to find a displacement for every bucket, largest buckets first
+bool displace(
+  const std::vector<uint32_t> & keys, uint32_t num_buckets, std::vector<uint32_t> & displacements)
+{
+  constexpr uint32_t MAX_DISPLACEMENT = 1U << 20U;
+
+  const auto num_keys = static_cast<uint32_t>(keys.size());
+  std::vector<std::vector<uint32_t>> buckets(num_buckets);
+
+  for (const auto key : keys) {
+    buckets[dispatch_reduce(dispatch_hash(key, 0U), num_buckets)].push_back(key);
+  }
+
+  std::vector<uint32_t> order(num_buckets);
+  std::iota(order.begin(), order.end(), 0U);
+  std::stable_sort(order.begin(), order.end(),
+    [&buckets](uint32_t a, uint32_t b){ return buckets[a].size() > buckets[b].size(); });
+
+  std::vector<bool> taken(num_keys, false);
+  std::vector<uint32_t> slots;
+  displacements.assign(num_buckets, 0U);
+
+  for (const auto bucket : order) {
+    if (buckets[bucket].empty()) {
+      break;
+    }
+
+    bool placed = false;
+
+    for (uint32_t displacement = 1U; displacement < MAX_DISPLACEMENT && !placed; ++displacement) {
+      slots.clear();
+      placed = true;
+
+      for (const auto key : buckets[bucket]) {
+        const auto slot = dispatch_reduce(dispatch_hash(key, displacement), num_keys);
+
+        if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+          placed = false;
+          break;
+        }
+
+        slots.push_back(slot);
+      }
+
+      if (placed) {
+        for (const auto slot : slots) {
+          taken[slot] = true;
+        }
+
+        displacements[bucket] = displacement;
+      }
+    }
+
+    if (!placed) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+DispatchTable build_dispatch_table(const std::vector<uint32_t> & keys)
+{
+  DispatchTable table{true, 0U, {}};
+
+  for (const auto key : keys) {
+    if (key > DIRECT_DISPATCH_MAX_KEY) {
+      table.is_direct = false;
+      break;
+    }
+  }
+
+  if (table.is_direct) {
+    return table;
+  }
+
+  // Around four keys per bucket keeps the displacement table small. Should a bucket not
+  // fit, which is very unlikely, retry with smaller buckets.
+  table.num_buckets = std::max<uint32_t>(1U, static_cast<uint32_t>((keys.size() + 3U) / 4U));
+
+  while (!displace(keys, table.num_buckets, table.displacements)) {
+    table.num_buckets *= 2U;
+  }
+
+  return table;
+}
+
+}  // namespace DbcDriverGen
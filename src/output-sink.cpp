@@ -0,0 +1,187 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dbc-driver-gen/output-sink.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "dbc-driver-gen/profiler.hpp"
+
+namespace DbcDriverGen
+{
+
+namespace
+{
+
+constexpr std::size_t WRITE_BUFFER_SIZE = 256U * 1024U;
+constexpr std::size_t COMPARE_CHUNK_SIZE = 64U * 1024U;
+
+bool files_equal(const std::filesystem::path & lhs, const std::filesystem::path & rhs)
+{
+  std::error_code ec;
+  const auto lhs_size = std::filesystem::file_size(lhs, ec);
+
+  if (ec || lhs_size != std::filesystem::file_size(rhs, ec) || ec) {
+    return false;
+  }
+
+  std::ifstream lhs_file(lhs, std::ios::binary);
+  std::ifstream rhs_file(rhs, std::ios::binary);
+  std::vector<char> lhs_chunk(COMPARE_CHUNK_SIZE);
+  std::vector<char> rhs_chunk(COMPARE_CHUNK_SIZE);
+
+  while (lhs_file && rhs_file) {
+    lhs_file.read(lhs_chunk.data(), lhs_chunk.size());
+    rhs_file.read(rhs_chunk.data(), rhs_chunk.size());
+
+    if (lhs_file.gcount() != rhs_file.gcount() ||
+      !std::equal(lhs_chunk.begin(), lhs_chunk.begin() + lhs_file.gcount(), rhs_chunk.begin()))
+    {
+      return false;
+    }
+  }
+
+  return lhs_file.eof() && rhs_file.eof();
+}
+
+}  // namespace
+
+void OutputSink::write_stream(
+  const std::filesystem::path & relative_path,
+  const std::function<void(std::ostream &)> & producer)
+{
+  std::ostringstream content;
+  producer(content);
+  write(relative_path, content.str());
+}
+
+DirectorySink::DirectorySink(const std::filesystem::path & root_folder, Profiler * profiler)
+: m_root_folder(root_folder),
+  m_profiler(profiler)
+{
+}
+
+std::filesystem::path DirectorySink::prepare_output_file(
+  const std::filesystem::path & relative_path) const
+{
+  const auto output_file = m_root_folder / relative_path;
+  const auto output_folder = output_file.parent_path();
+
+  // Several writers may race to create the same folder, which is not an error
+  std::error_code ec;
+  std::filesystem::create_directories(output_folder, ec);
+
+  if (ec && !std::filesystem::is_directory(output_folder)) {
+    std::filesystem::filesystem_error
+      fe{"Failed creating output directory.", output_folder, ec};
+    throw fe;
+  }
+
+  return output_file;
+}
+
+void DirectorySink::write(const std::filesystem::path & relative_path, const std::string & content)
+{
+  const auto output_file = prepare_output_file(relative_path);
+  std::error_code ec;
+
+  // Leave files with identical content untouched so their timestamps do not
+  // trigger recompilation of everything that includes them
+  if (std::filesystem::file_size(output_file, ec) == content.size() && !ec) {
+    std::ifstream existing(output_file, std::ios::binary);
+    std::string existing_content(content.size(), '\0');
+
+    if (existing.read(existing_content.data(), existing_content.size()) &&
+      existing_content == content)
+    {
+      return;
+    }
+  }
+
+  std::ofstream file(output_file, std::ios::binary);
+  file << content;
+  file.close();
+
+  if (!file) {
+    auto fsec = std::make_error_code(std::errc::io_error);
+    std::filesystem::filesystem_error
+      fe{"Failed writing generated file.", output_file, fsec};
+    throw fe;
+  }
+}
+
+void DirectorySink::write_stream(
+  const std::filesystem::path & relative_path,
+  const std::function<void(std::ostream &)> & producer)
+{
+  const auto output_file = prepare_output_file(relative_path);
+  auto temp_file = output_file;
+  temp_file += ".tmp";
+
+  std::vector<char> buffer(WRITE_BUFFER_SIZE);
+  std::ofstream file;
+  file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  file.open(temp_file, std::ios::binary | std::ios::trunc);
+
+  try {
+    producer(file);
+  } catch (...) {
+    file.close();
+    std::error_code ec;
+    std::filesystem::remove(temp_file, ec);
+    throw;
+  }
+
+  // Rendering is timed by the producer, the last flush, comparison and rename are writing
+  Profiler::Scope scope(m_profiler, "write file", relative_path.string());
+
+  file.close();
+
+  if (!file) {
+    std::filesystem::remove(temp_file);
+    auto fsec = std::make_error_code(std::errc::io_error);
+    std::filesystem::filesystem_error
+      fe{"Failed writing generated file.", output_file, fsec};
+    throw fe;
+  }
+
+  // Leave files with identical content untouched so their timestamps do not
+  // trigger recompilation of everything that includes them
+  if (files_equal(temp_file, output_file)) {
+    std::filesystem::remove(temp_file);
+  } else {
+    std::filesystem::rename(temp_file, output_file);
+  }
+}
+
+void MemorySink::write(const std::filesystem::path & relative_path, const std::string & content)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_files[relative_path] = content;
+}
+
+GeneratedFiles MemorySink::take_files()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  GeneratedFiles files;
+  std::swap(files, m_files);
+  return files;
+}
+
+}  // namespace DbcDriverGen
@@ -0,0 +1,211 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dbc-driver-gen/profiler.hpp"
+
+#include <sys/resource.h>
+#include <time.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+
+#include "dbc-driver-gen/third-party/json.hpp"
+
+namespace DbcDriverGen
+{
+
+namespace
+{
+
+double to_ms(const std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double to_us(const std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+}  // namespace
+
+Profiler::Scope::Scope(Profiler * profiler, const std::string & category, const std::string & name)
+: m_profiler(profiler)
+{
+  if (m_profiler == nullptr) {
+    return;
+  }
+
+  m_event.category = category;
+  m_event.name = name;
+  m_event.thread = m_profiler->thread_index();
+  m_event.start = std::chrono::steady_clock::now() - m_profiler->m_start;
+  m_event.cpu_time = thread_cpu_time();
+  m_event.allocations = m_profiler->allocations();
+}
+
+Profiler::Scope::~Scope()
+{
+  if (m_profiler == nullptr) {
+    return;
+  }
+
+  m_event.allocations = m_profiler->allocations() - m_event.allocations;
+  m_event.cpu_time = thread_cpu_time() - m_event.cpu_time;
+  m_event.wall_time =
+    (std::chrono::steady_clock::now() - m_profiler->m_start) - m_event.start;
+
+  m_profiler->record(m_event);
+}
+
+Profiler::Profiler(AllocationCounter allocation_counter)
+: m_allocation_counter(allocation_counter),
+  m_start(std::chrono::steady_clock::now())
+{
+}
+
+std::vector<Profiler::Event> Profiler::events() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_events;
+}
+
+long Profiler::peak_rss_kb()
+{
+  struct rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+void Profiler::write_table(std::ostream & os) const
+{
+  const auto all_events = events();
+
+  os << std::left << std::setw(18) << "Phase" << std::setw(44) << "Name" << std::right <<
+    std::setw(7) << "Thread" << std::setw(12) << "Wall (ms)" << std::setw(12) << "CPU (ms)" <<
+    std::setw(12) << "Allocs" << "\n";
+
+  for (const auto & event : all_events) {
+    os << std::left << std::setw(18) << event.category << std::setw(44) << event.name <<
+      std::right << std::setw(7) << event.thread << std::fixed << std::setprecision(3) <<
+      std::setw(12) << to_ms(event.wall_time) << std::setw(12) << to_ms(event.cpu_time) <<
+      std::setw(12) << event.allocations << "\n";
+  }
+
+  // Summary per category in order of first appearance
+  struct Total
+  {
+    std::string category;
+    std::size_t count;
+    std::chrono::nanoseconds wall_time;
+    std::chrono::nanoseconds cpu_time;
+    std::uint64_t allocations;
+  };
+
+  std::vector<Total> totals;
+
+  for (const auto & event : all_events) {
+    auto it = std::find_if(totals.begin(), totals.end(),
+      [&event](const Total & total){ return total.category == event.category; });
+
+    if (it == totals.end()) {
+      totals.push_back({event.category, 0U, {}, {}, 0U});
+      it = std::prev(totals.end());
+    }
+
+    ++it->count;
+    it->wall_time += event.wall_time;
+    it->cpu_time += event.cpu_time;
+    it->allocations += event.allocations;
+  }
+
+  os << "\n" << std::left << std::setw(18) << "Phase" << std::right << std::setw(8) << "Count" <<
+    std::setw(12) << "Wall (ms)" << std::setw(12) << "CPU (ms)" << std::setw(12) << "Allocs" <<
+    "\n";
+
+  for (const auto & total : totals) {
+    os << std::left << std::setw(18) << total.category << std::right << std::setw(8) <<
+      total.count << std::fixed << std::setprecision(3) << std::setw(12) <<
+      to_ms(total.wall_time) << std::setw(12) << to_ms(total.cpu_time) << std::setw(12) <<
+      total.allocations << "\n";
+  }
+
+  os << "\nPeak RSS: " << peak_rss_kb() << " kB" << std::endl;
+}
+
+void Profiler::write_chrome_trace(std::ostream & os) const
+{
+  using nlohmann::json;
+
+  json trace;
+  auto & trace_events = trace["traceEvents"];
+  trace_events = json::array();
+
+  std::chrono::nanoseconds end{0};
+
+  for (const auto & event : events()) {
+    trace_events.push_back({
+        {"name", event.name},
+        {"cat", event.category},
+        {"ph", "X"},
+        {"ts", to_us(event.start)},
+        {"dur", to_us(event.wall_time)},
+        {"pid", 1},
+        {"tid", event.thread},
+        {"args", {
+            {"cpu_ms", to_ms(event.cpu_time)},
+            {"allocations", event.allocations}}}});
+
+    end = std::max(end, event.start + event.wall_time);
+  }
+
+  trace_events.push_back({
+      {"name", "peak_rss_kb"},
+      {"ph", "C"},
+      {"ts", to_us(end)},
+      {"pid", 1},
+      {"args", {{"peak_rss_kb", peak_rss_kb()}}}});
+
+  trace["displayTimeUnit"] = "ms";
+
+  os << trace.dump(1) << std::endl;
+}
+
+void Profiler::record(const Event & event)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.push_back(event);
+}
+
+std::uint32_t Profiler::thread_index()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_threads.emplace(std::this_thread::get_id(), m_threads.size()).first;
+  return it->second;
+}
+
+std::uint64_t Profiler::allocations() const
+{
+  return m_allocation_counter == nullptr ? 0U : m_allocation_counter();
+}
+
+std::chrono::nanoseconds Profiler::thread_cpu_time()
+{
+  struct timespec ts {};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+}  // namespace DbcDriverGen
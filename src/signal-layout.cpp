@@ -0,0 +1,437 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dbc-driver-gen/signal-layout.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace DbcDriverGen
+{
+
+std::vector<SignalSegment> signal_segments(uint32_t start_bit, uint32_t size, bool is_bigendian)
+{
+  std::vector<SignalSegment> segments;
+
+  // For Intel signals the start bit is the LSB, counted from bit 0 of byte 0 upwards.
+  // For Motorola signals it is the MSB, and the signal continues at bit 7 of the next byte.
+  uint32_t index = start_bit / 8U;
+  uint32_t pos = start_bit % 8U;
+  uint32_t left = size;
+
+  while (left > 0U) {
+    uint32_t length;
+    int32_t value_shift;
+    uint32_t mask;
+
+    if (is_bigendian) {
+      if (left >= pos + 1U) {
+        length = pos + 1U;
+        value_shift = static_cast<int32_t>(left - length);
+        mask = (1U << length) - 1U;
+        pos = 7U;
+      } else {
+        length = left;
+        value_shift = -static_cast<int32_t>(pos - length + 1U);
+        mask = ((1U << length) - 1U) << (pos - length + 1U);
+      }
+    } else {
+      value_shift = static_cast<int32_t>(size - left) - static_cast<int32_t>(pos);
+
+      if (left >= 8U - pos) {
+        length = 8U - pos;
+        mask = ((1U << length) - 1U) << pos;
+        pos = 0U;
+      } else {
+        length = left;
+        mask = ((1U << length) - 1U) << pos;
+      }
+    }
+
+    segments.push_back({index, static_cast<uint8_t>(mask), value_shift});
+
+    left -= length;
+    ++index;
+  }
+
+  return segments;
+}
+
+uint32_t container_bits(uint32_t bits)
+{
+  if (bits <= 8U) {
+    return 8U;
+  } else if (bits <= 16U) {
+    return 16U;
+  } else if (bits <= 32U) {
+    return 32U;
+  }
+
+  return 64U;
+}
+
+std::string unsigned_type(uint32_t bits)
+{
+  return "uint" + std::to_string(container_bits(bits)) + "_t";
+}
+
+std::string signed_type(uint32_t bits)
+{
+  return "int" + std::to_string(container_bits(bits)) + "_t";
+}
+
+std::string hex_literal(uint64_t value, uint32_t bits)
+{
+  std::ostringstream literal;
+  literal << "0x" << std::uppercase << std::hex << value << (bits > 32U ? "ULL" : "U");
+  return literal.str();
+}
+
+std::size_t frame_length(std::size_t payload_size)
+{
+  // Lengths of the data length codes 9 to 15
+  constexpr std::size_t FD_LENGTHS[] = {12U, 16U, 20U, 24U, 32U, 48U, MAX_FD_PAYLOAD_SIZE};
+
+  if (payload_size <= 8U) {
+    return payload_size;
+  }
+
+  for (const std::size_t length : FD_LENGTHS) {
+    if (payload_size <= length) {
+      return length;
+    }
+  }
+
+  return MAX_FD_PAYLOAD_SIZE;
+}
+
+std::optional<FixedPointScaling> fixed_point_scaling(double factor, double offset)
+{
+  // Keeps scale and offset well inside int64_t, so the range of a signal can be checked with
+  // doubles before it is computed exactly
+  constexpr double MAX_COEFFICIENT = 2147483648.0;
+
+  const auto as_integer = [](double value, int64_t & integer) {
+      const double rounded = std::round(value);
+
+      if (std::fabs(rounded) >= MAX_COEFFICIENT ||
+        std::fabs(value - rounded) > 1e-9 * std::max(1.0, std::fabs(value)))
+      {
+        return false;
+      }
+
+      integer = static_cast<int64_t>(rounded);
+      return true;
+    };
+
+  double power = 1.0;
+
+  for (uint32_t digits = 0U; digits <= MAX_FIXED_POINT_DIGITS; ++digits) {
+    FixedPointScaling scaling{-static_cast<int32_t>(digits), 0, 0};
+
+    if (as_integer(factor * power, scaling.scale) && as_integer(offset * power, scaling.offset)) {
+      if (scaling.scale == 0) {
+        return std::nullopt;
+      }
+
+      return scaling;
+    }
+
+    power *= 10.0;
+  }
+
+  return std::nullopt;
+}
+
+namespace
+{
+
+/// A term adding value to an expression, as an integer literal of the given type
+std::string add_term(int64_t value, bool is_unsigned, uint32_t bits)
+{
+  return (value < 0 ? " - " : " + ") + std::to_string(value < 0 ? -value : value) +
+         (is_unsigned ? "U" : "") + (bits > 32U ? "LL" : "");
+}
+
+/// Choose the integer type of a fixed-point signal and add how it is decoded and encoded, or
+/// return false if its values do not fit into 64 bits
+bool add_fixed_point(inja::json & signal, const FixedPointScaling & scaling)
+{
+  const uint32_t size = signal["size"];
+  const bool is_signed = signal["is_signed"];
+
+  if (size > 62U) {
+    return false;
+  }
+
+  const int64_t raw_min = is_signed ? -(int64_t{1} << (size - 1U)) : 0;
+  const int64_t raw_max = is_signed ? (int64_t{1} << (size - 1U)) - 1 : (int64_t{1} << size) - 1;
+
+  // Both the scaled raw value and the result must fit, decoding computes them in this type
+  const double bound = std::max(std::fabs(static_cast<double>(raw_min)),
+      static_cast<double>(raw_max)) * std::fabs(static_cast<double>(scaling.scale)) +
+    std::fabs(static_cast<double>(scaling.offset));
+
+  if (bound >= 4611686018427387904.0) {
+    return false;
+  }
+
+  const int64_t scaled[] = {raw_min * scaling.scale, raw_max * scaling.scale};
+  const int64_t lowest = std::min({scaled[0], scaled[1], scaled[0] + scaling.offset,
+      scaled[1] + scaling.offset});
+  const int64_t highest = std::max({scaled[0], scaled[1], scaled[0] + scaling.offset,
+      scaled[1] + scaling.offset});
+
+  uint32_t bits = 1U;
+  std::string rep;
+
+  if (lowest >= 0) {
+    while (bits < 63U && (highest >> bits) != 0) {
+      ++bits;
+    }
+
+    rep = unsigned_type(bits);
+  } else {
+    bits = 2U;
+
+    while (bits < 64U &&
+      (lowest < -(int64_t{1} << (bits - 1U)) || highest > (int64_t{1} << (bits - 1U)) - 1))
+    {
+      ++bits;
+    }
+
+    rep = signed_type(bits);
+  }
+
+  const uint32_t rep_bits = container_bits(bits);
+  const bool is_unsigned = lowest >= 0;
+  const std::string name = signal["name"];
+  const std::string value_type = signal["value_type"];
+
+  signal["type"] = "FixedPoint<" + rep + ", " + std::to_string(scaling.exponent) + ">";
+  signal["storage_size"] = rep_bits / 8U;
+
+  // Decoding computes (raw * scale + offset) in the integer type of the value
+  std::string decode = rep == value_type ? "raw" : "static_cast<" + value_type + ">(raw)";
+
+  if (scaling.scale != 1 || scaling.offset != 0) {
+    decode = "static_cast<" + rep + ">(" + decode + ")";
+  }
+
+  if (scaling.scale != 1) {
+    decode += " * " + std::to_string(scaling.scale) + (is_unsigned ? "U" : "") +
+      (rep_bits > 32U ? "LL" : "");
+  }
+
+  if (scaling.offset != 0) {
+    decode += add_term(scaling.offset, is_unsigned, rep_bits);
+  }
+
+  signal["fixed_decode"] = "static_cast<" + rep + ">(" + decode + ")";
+
+  // Encoding computes (value - offset) / scale in int64_t, rounded to the nearest raw value
+  std::string encode = name + ".value";
+
+  if (scaling.offset != 0) {
+    encode = "static_cast<int64_t>(" + encode + ")" + add_term(-scaling.offset, false, 32U);
+  }
+
+  if (scaling.scale != 1) {
+    encode = "detail::divide_rounded(" +
+      (scaling.offset != 0 ? encode : "static_cast<int64_t>(" + encode + ")") + ", " +
+      std::to_string(scaling.scale) + ")";
+  }
+
+  signal["fixed_encode"] = encode;
+
+  return true;
+}
+
+}  // namespace
+
+void add_signal_layout(inja::json & signal, ValueRepresentation representation)
+{
+  const uint32_t start_bit = signal["start_bit"];
+  const uint32_t size = signal["size"];
+  const bool is_bigendian = signal["is_bigendian"];
+  const bool is_signed = signal["is_signed"];
+  const double factor = signal["factor"];
+  const double offset = signal["offset"];
+
+  const uint32_t raw_bits = container_bits(size);
+  const bool is_scaled = factor != 1.0 || offset != 0.0;
+
+  signal["raw_type"] = unsigned_type(size);
+  signal["signed_type"] = signed_type(size);
+  signal["value_type"] = is_signed ? signed_type(size) : unsigned_type(size);
+
+  // Notation used by the DBC, for documentation of the generated code
+  signal["dbc_byte_order"] = is_bigendian ? "0" : "1";
+  signal["dbc_sign"] = is_signed ? "-" : "+";
+
+  // Unscaled signals keep their integer value, everything else is a physical value
+  signal["representation"] = "integer";
+  signal["storage_size"] = raw_bits / 8U;
+
+  if (is_scaled && representation == ValueRepresentation::RAW) {
+    signal["representation"] = "raw";
+    signal["type"] = signal["value_type"];
+  } else if (is_scaled) {
+    const auto scaling = representation == ValueRepresentation::FIXED_POINT ?
+      fixed_point_scaling(factor, offset) : std::nullopt;
+
+    if (scaling && add_fixed_point(signal, *scaling)) {
+      signal["representation"] = "fixed_point";
+    } else if (representation == ValueRepresentation::FIXED_POINT && size <= 24U) {
+      signal["representation"] = "float";
+      signal["type"] = "float";
+      signal["storage_size"] = sizeof(float);
+    } else {
+      signal["representation"] = "double";
+      signal["type"] = "double";
+      signal["storage_size"] = sizeof(double);
+    }
+  } else if (size == 1U && !is_signed) {
+    signal["type"] = "bool";
+    signal["storage_size"] = sizeof(bool);
+  } else {
+    signal["type"] = is_signed ? signed_type(size) : unsigned_type(size);
+  }
+
+  signal["is_scaled"] = is_scaled;
+
+  // Sign extension of the raw value into its container type
+  signal["needs_sign_extension"] = is_signed && size < raw_bits;
+
+  if (is_signed && size < raw_bits) {
+    const uint64_t container_mask = raw_bits == 64U ? ~0ULL : ((1ULL << raw_bits) - 1ULL);
+    const uint64_t value_mask = (1ULL << size) - 1ULL;
+
+    signal["sign_bit"] = hex_literal(1ULL << (size - 1U), raw_bits);
+    signal["sign_extension"] = hex_literal(container_mask & ~value_mask, raw_bits);
+  }
+
+  signal["segments"] = inja::json::array();
+
+  for (const auto & segment : signal_segments(start_bit, size, is_bigendian)) {
+    inja::json seg;
+    seg["index"] = segment.index;
+    seg["mask"] = hex_literal(segment.mask, 8U);
+    seg["shift_left"] = segment.value_shift > 0;
+    seg["shift"] = segment.value_shift >= 0 ? segment.value_shift : -segment.value_shift;
+    signal["segments"].push_back(std::move(seg));
+  }
+}
+
+void add_struct_layout(inja::json & message)
+{
+  const auto & signals = message["signals"];
+  std::vector<std::size_t> order(signals.size());
+  std::vector<bool> is_received(signals.size());
+  std::size_t struct_size = 0U;
+  std::size_t alignment = 1U;
+
+  for (std::size_t i = 0U; i < signals.size(); ++i) {
+    const auto & receivers = signals[i]["receivers"];
+
+    // Vector__XXX is the DBC's placeholder for no receiver
+    order[i] = i;
+    is_received[i] = std::any_of(receivers.begin(), receivers.end(),
+        [](const inja::json & receiver) {return receiver != "Vector__XXX";});
+
+    const std::size_t size = signals[i]["storage_size"];
+    struct_size += size;
+    alignment = std::max(alignment, size);
+  }
+
+  // All sizes are powers of two, so decreasing sizes leave no gaps
+  std::stable_sort(order.begin(), order.end(),
+    [&signals, &is_received](std::size_t lhs, std::size_t rhs) {
+      const std::size_t lhs_size = signals[lhs]["storage_size"];
+      const std::size_t rhs_size = signals[rhs]["storage_size"];
+      return lhs_size != rhs_size ? lhs_size > rhs_size : is_received[lhs] > is_received[rhs];
+    });
+
+  message["field_order"] = order;
+  message["struct_size"] = signals.empty() ? 1U :
+    (struct_size + alignment - 1U) / alignment * alignment;
+}
+
+void add_vector_groups(inja::json & message)
+{
+  auto & signals = message["signals"];
+  const uint32_t message_size = message["size"];
+
+  const auto is_lane = [](const inja::json & signal) {
+      const uint32_t size = signal["size"];
+      const uint32_t start_bit = signal["start_bit"];
+      return (size == 8U || size == 16U) && start_bit % 8U == 0U &&
+             !signal["is_bigendian"].get<bool>() && signal["representation"] == "double";
+    };
+
+  const auto continues = [](const inja::json & previous, const inja::json & signal) {
+      const uint32_t size = previous["size"];
+      const uint32_t start_bit = previous["start_bit"];
+      return signal["size"] == size && signal["start_bit"] == start_bit + size &&
+             signal["is_signed"] == previous["is_signed"] &&
+             signal["factor"] == previous["factor"] && signal["offset"] == previous["offset"];
+    };
+
+  for (auto & signal : signals) {
+    signal["is_vector_lane"] = false;
+    signal["starts_vector_group"] = false;
+  }
+
+  std::size_t first = 0U;
+
+  while (first < signals.size()) {
+    std::size_t end = first + 1U;
+
+    if (is_lane(signals[first])) {
+      while (end < signals.size() && is_lane(signals[end]) &&
+        continues(signals[end - 1U], signals[end]))
+      {
+        ++end;
+      }
+    }
+
+    const uint32_t size = signals[first]["size"];
+    const uint32_t byte_offset = signals[first]["start_bit"].get<uint32_t>() / 8U;
+    const std::size_t count = end - first;
+
+    // Kernels load whole lanes, which must lie within the payload
+    if (is_lane(signals[first]) && count >= MIN_VECTOR_GROUP_SIZE &&
+      byte_offset + count * size / 8U <= message_size)
+    {
+      inja::json group;
+      group["lane_type"] = signals[first]["value_type"];
+      group["byte_offset"] = byte_offset;
+      group["count"] = count;
+      group["members"] = inja::json::array();
+
+      for (std::size_t i = first; i < end; ++i) {
+        signals[i]["is_vector_lane"] = true;
+        group["members"].push_back(signals[i]["name"]);
+      }
+
+      signals[first]["starts_vector_group"] = true;
+      signals[first]["vector_group"] = std::move(group);
+    }
+
+    first = end;
+  }
+}
+
+}  // namespace DbcDriverGen
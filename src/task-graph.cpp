@@ -0,0 +1,160 @@
+// Copyright 2024 Electrified Autonomy
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dbc-driver-gen/task-graph.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace DbcDriverGen
+{
+
+TaskGraph::TaskId TaskGraph::add_task(
+  const std::string & phase,
+  std::function<void()> work,
+  const std::vector<TaskId> & dependencies)
+{
+  const TaskId id = m_tasks.size();
+
+  for (const auto dep : dependencies) {
+    if (dep >= id) {
+      throw std::out_of_range("Task dependency refers to a task which does not exist yet.");
+    }
+    m_tasks[dep].dependents.push_back(id);
+  }
+
+  Task task;
+  task.phase = phase;
+  task.work = std::move(work);
+  task.num_dependencies = dependencies.size();
+  m_tasks.push_back(std::move(task));
+
+  return id;
+}
+
+void TaskGraph::run(std::size_t num_threads)
+{
+  if (num_threads == 0U) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  num_threads = std::min(num_threads, std::max<std::size_t>(m_tasks.size(), 1U));
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<TaskId> ready;
+  std::vector<std::size_t> remaining_deps(m_tasks.size());
+  std::size_t num_unfinished = m_tasks.size();
+  std::exception_ptr error;
+
+  for (TaskId id = 0; id < m_tasks.size(); ++id) {
+    remaining_deps[id] = m_tasks[id].num_dependencies;
+    if (remaining_deps[id] == 0U) {
+      ready.push_back(id);
+    }
+  }
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+      cv.wait(lock, [&]() {return !ready.empty() || num_unfinished == 0U || error;});
+
+      if (num_unfinished == 0U || error) {
+        return;
+      }
+
+      const TaskId id = ready.front();
+      ready.pop_front();
+
+      lock.unlock();
+
+      auto & task = m_tasks[id];
+      std::exception_ptr task_error;
+
+      task.start = Clock::now();
+      try {
+        task.work();
+      } catch (...) {
+        task_error = std::current_exception();
+      }
+      task.end = Clock::now();
+
+      lock.lock();
+
+      if (task_error) {
+        if (!error) {
+          error = task_error;
+        }
+      } else {
+        for (const auto dependent : task.dependents) {
+          if (--remaining_deps[dependent] == 0U) {
+            ready.push_back(dependent);
+          }
+        }
+      }
+
+      --num_unfinished;
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::vector<std::pair<std::string, std::chrono::nanoseconds>> TaskGraph::phase_durations() const
+{
+  std::vector<std::pair<std::string, std::chrono::nanoseconds>> durations;
+  std::vector<std::pair<Clock::time_point, Clock::time_point>> spans;
+
+  for (const auto & task : m_tasks) {
+    auto it = std::find_if(durations.begin(), durations.end(),
+      [&task](const auto & d){ return d.first == task.phase; });
+
+    if (it == durations.end()) {
+      durations.emplace_back(task.phase, std::chrono::nanoseconds{0});
+      spans.emplace_back(task.start, task.end);
+    } else {
+      auto & span = spans[static_cast<std::size_t>(it - durations.begin())];
+      span.first = std::min(span.first, task.start);
+      span.second = std::max(span.second, task.end);
+    }
+  }
+
+  for (std::size_t i = 0; i < durations.size(); ++i) {
+    durations[i].second =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(spans[i].second - spans[i].first);
+  }
+
+  return durations;
+}
+
+}  // namespace DbcDriverGen